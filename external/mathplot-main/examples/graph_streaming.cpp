@@ -0,0 +1,60 @@
+/*
+ * Visualize a live 'telemetry' signal with a GraphVisual in streaming mode. Only the most recent
+ * data are held and drawn, new vertices are uploaded to the GPU incrementally and the line is
+ * min/max decimated to the on-screen width of the graph.
+ */
+#include <iostream>
+#include <cmath>
+
+#include <sm/vec>
+#include <sm/vvec>
+#include <sm/random>
+
+#include <mplot/Visual.h>
+#include <mplot/GraphVisual.h>
+
+int main()
+{
+    int rtn = -1;
+
+    mplot::Visual v(1024, 768, "Streaming graph");
+    v.backgroundWhite();
+
+    try {
+        auto gv = std::make_unique<mplot::GraphVisual<float>> (sm::vec<float>({-0.65f, -0.5f, 0.0f}));
+        v.bindmodel (gv);
+        gv->setsize (1.33, 1);
+        gv->setlimits (0, 1, -1.5, 1.5);
+        gv->policy = mplot::stylepolicy::lines;
+        gv->prepdata ("Telemetry");
+        gv->xlabel = "t (s)";
+        gv->ylabel = "signal";
+        gv->auto_rescale_x = true;
+
+        // Hold the last 50000 samples and decimate the line to about 800 pixel columns
+        gv->setstreaming (50000, 800);
+
+        gv->finalize();
+        auto gvp = v.addVisualModel (gv);
+
+        sm::rand_normal<float> noise (0.0f, 0.1f);
+        constexpr float dt = 0.0001f;
+        constexpr int samples_per_frame = 200;
+        float t = 0.0f;
+        while (v.readyToFinish() == false) {
+            v.poll();
+            for (int i = 0; i < samples_per_frame; ++i) {
+                gvp->append (t, std::sin (2.0f * sm::mathconst<float>::pi * t) + noise.get(), 0);
+                t += dt;
+            }
+            v.render();
+        }
+        rtn = 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        rtn = -1;
+    }
+
+    return rtn;
+}
@@ -0,0 +1,77 @@
+/*
+ * Test cartgrid::find_nearest against a linear search and profile it.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <limits>
+
+#include <sm/cartgrid>
+#include <sm/random>
+#include <sm/vvec>
+#include <sm/vec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+int main()
+{
+    int rtn = 0;
+
+    sm::rand_uniform<float> rng (0.0f, 1.0f, 1357);
+
+    for (float span : { 1.0f, 3.0f, 10.0f }) {
+        // Rectangular elements, 0.01 by 0.02
+        sm::cartgrid cg (0.01f, 0.02f, span, span);
+        cg.setBoundaryOnOuterEdge();
+
+        // Queries over an area 20% larger than the grid
+        constexpr unsigned int nq = 1000000;
+        sm::vvec<sm::vec<float, 2>> queries (nq);
+        for (auto& q : queries) { q = { (rng.get() - 0.5f) * 1.2f * span, (rng.get() - 0.5f) * 1.2f * span }; }
+
+        sc::time_point t0 = sc::now();
+        sm::vvec<int> nearest = cg.find_nearest (queries);
+        sc::duration t_batch = sc::now() - t0;
+
+        constexpr unsigned int nlin = 200;
+        t0 = sc::now();
+        for (unsigned int i = 0; i < nlin; ++i) {
+            float d = std::numeric_limits<float>::max();
+            for (unsigned int j = 0; j < cg.d_x.size(); ++j) {
+                d = std::min (d, (queries[i] - sm::vec<float, 2>{ cg.d_x[j], cg.d_y[j] }).length());
+            }
+            int ni = nearest[i];
+            float d_idx = (queries[i] - sm::vec<float, 2>{ cg.d_x[ni], cg.d_y[ni] }).length();
+            if (std::abs (d - d_idx) > 1e-6f) {
+                std::cout << "Fail: query " << i << " found a rect at " << d_idx << " not " << d << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        sc::duration t_lin = sc::now() - t0;
+
+        for (unsigned int i = 0; i < 1000; ++i) {
+            if (cg.find_nearest (queries[i]) != nearest[i]) {
+                std::cout << "Fail: single and batch find_nearest disagree\n";
+                --rtn;
+                break;
+            }
+        }
+        for (unsigned int i = 0; i < cg.d_x.size(); i += 97) {
+            if (cg.find_rect_at ({ cg.d_x[i], cg.d_y[i] }) != static_cast<int>(i)) {
+                std::cout << "Fail: find_rect_at did not find rect " << i << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        if (cg.find_rect_at ({ span, span }) != -1) { std::cout << "Fail: find_rect_at outside grid\n"; --rtn; }
+
+        std::cout << cg.num() << " rects:\n"
+                  << "  linear search:          " << duration_cast<nanoseconds>(t_lin).count() / nlin << " ns per query\n"
+                  << "  find_nearest (batch):   " << duration_cast<nanoseconds>(t_batch).count() / nq << " ns per query\n";
+    }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,205 @@
+/*
+ * Test time series storage with sm::hdfdata: appendable, chunked (and compressed) datasets of
+ * frames, partial reads of frames and value ranges, streaming through the frames with
+ * hdfdata::frame_reader, and reading whole datasets directly into contiguous containers.
+ */
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include <list>
+#include <vector>
+#include <sm/hdfdata>
+#include <sm/vvec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// The value of hex j in frame i. Repetitive, so that it compresses well.
+float val (unsigned int i, unsigned int j) { return static_cast<float>((i + j) % 100) * 0.5f; }
+
+sm::vvec<float> make_frame (unsigned int i, unsigned int n)
+{
+    sm::vvec<float> f (n);
+    for (unsigned int j = 0; j < n; ++j) { f[j] = val (i, j); }
+    return f;
+}
+
+long int file_size (const char* fname)
+{
+    std::FILE* fp = std::fopen (fname, "rb");
+    if (fp == nullptr) { return -1; }
+    std::fseek (fp, 0, SEEK_END);
+    long int sz = std::ftell (fp);
+    std::fclose (fp);
+    return sz;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr unsigned int n = 1000;    // values (hexes) per frame
+    constexpr unsigned int nf1 = 200;   // frames written at first
+    constexpr unsigned int nf2 = 50;    // frames appended after re-opening the file
+    const char* fname = "testhdfdata6.h5";
+    const char* fname_raw = "testhdfdata6_raw.h5";
+
+    sm::vvec<double> line (5000);
+    line.linspace (0.0, 1.0);
+
+    {
+        sm::hdfdata data (fname, sm::file_access_mode::truncate_write);
+        data.create_appendable<float> ("/sim/hexvals", n, 0, 6);
+        for (unsigned int i = 0; i < nf1; ++i) { data.append_frame ("/sim/hexvals", make_frame (i, n)); }
+        data.add_contained_vals ("/line", line);
+
+        // A frame of the wrong size is refused
+        bool threw = false;
+        try {
+            data.append_frame ("/sim/hexvals", sm::vvec<float>(n - 1, 0.0f));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) { std::cout << "Fail: appending a frame of the wrong size did not throw\n"; --rtn; }
+    }
+    {
+        // Uncompressed, for comparison
+        sm::hdfdata data (fname_raw, sm::file_access_mode::truncate_write);
+        data.create_appendable<float> ("/sim/hexvals", n);
+        for (unsigned int i = 0; i < nf1; ++i) { data.append_frame ("/sim/hexvals", make_frame (i, n)); }
+    }
+    {
+        // Continue the time series; append two frames at once
+        sm::hdfdata data (fname, sm::file_access_mode::read_write);
+        data.create_appendable<float> ("/sim/hexvals", n);
+        for (unsigned int i = nf1; i < nf1 + nf2; i += 2) {
+            sm::vvec<float> two = make_frame (i, n);
+            two.concat (make_frame (i + 1, n));
+            data.append_frames ("/sim/hexvals", two);
+        }
+        // ...but not with another frame size
+        bool threw = false;
+        try {
+            data.create_appendable<float> ("/sim/hexvals", n + 1);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) { std::cout << "Fail: re-opening with the wrong frame size did not throw\n"; --rtn; }
+    }
+
+    const long int sz = file_size (fname);
+    const long int sz_raw = file_size (fname_raw);
+    if (sz <= 0 || sz_raw <= 0 || sz >= sz_raw) {
+        std::cout << "Fail: the compressed file (" << sz << " bytes) is not smaller than the uncompressed file ("
+                  << sz_raw << " bytes)\n";
+        --rtn;
+    }
+
+    {
+        sm::hdfdata data (fname, sm::file_access_mode::read_only);
+        data.on_read_error_action = sm::read_error_action::carry_on;
+
+        if (data.num_frames ("/sim/hexvals") != nf1 + nf2) {
+            std::cout << "Fail: " << data.num_frames ("/sim/hexvals") << " frames, not " << nf1 + nf2 << std::endl;
+            --rtn;
+        }
+
+        // One frame, some frames and a range of hexes in some frames
+        sm::vvec<float> f;
+        data.read_frame ("/sim/hexvals", 57, f);
+        if (f != make_frame (57, n)) { std::cout << "Fail: read_frame\n"; --rtn; }
+        data.read_frame ("/sim/hexvals", nf1 + 3, f);
+        if (f != make_frame (nf1 + 3, n)) { std::cout << "Fail: read_frame from the appended frames\n"; --rtn; }
+
+        data.read_frames ("/sim/hexvals", 10, 5, f, 100, 50);
+        bool ok = f.size() == 5 * 50;
+        for (unsigned int i = 0; ok && i < 5; ++i) {
+            for (unsigned int j = 0; j < 50; ++j) { ok = ok && f[i * 50 + j] == val (10 + i, 100 + j); }
+        }
+        if (!ok) { std::cout << "Fail: read_frames of a range of values\n"; --rtn; }
+
+        // A hyperslab into caller-provided storage
+        std::vector<float> slab (3 * 4, 0.0f);
+        data.read_hyperslab ("/sim/hexvals", { 20, 996 }, { 3, 4 }, slab.data());
+        if (slab[0] != val (20, 996) || slab[11] != val (22, 999)) { std::cout << "Fail: read_hyperslab\n"; --rtn; }
+
+        bool threw = false;
+        try {
+            data.read_hyperslab ("/sim/hexvals", { 20, 998 }, { 1, 4 }, slab.data());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) { std::cout << "Fail: an out of range hyperslab did not throw\n"; --rtn; }
+
+        // Part of a 1D dataset
+        sm::vvec<double> part;
+        data.read_range ("/line", 1000, 10, part);
+        if (part.size() != 10 || part[0] != line[1000] || part[9] != line[1009]) { std::cout << "Fail: read_range\n"; --rtn; }
+
+        // A missing path is handled with on_read_error_action
+        f = { 1.0f };
+        data.read_frames ("/sim/missing", 0, 1, f);
+        if (f.size() != 1) { std::cout << "Fail: reading a missing path changed vals\n"; --rtn; }
+
+        // Whole datasets are read directly into vvec/vector and via a vector into list
+        sm::vvec<double> line_in;
+        std::list<double> line_list;
+        data.read_contained_vals ("/line", line_in);
+        data.read_contained_vals ("/line", line_list);
+        if (line_in != line || line_list.size() != line.size() || line_list.back() != line.back()) {
+            std::cout << "Fail: read_contained_vals\n";
+            --rtn;
+        }
+
+        // Stream through all the frames, a block at a time
+        sm::hdfdata::frame_reader<float> frames (data, "/sim/hexvals");
+        unsigned int nread = 0;
+        unsigned int nwrong = 0;
+        while (frames.next (f)) {
+            if (f != make_frame (nread, n)) { ++nwrong; }
+            ++nread;
+        }
+
+        // Time a pass through the frames with a new reader, without copying the frames
+        double sum = 0.0;
+        sc::time_point t0 = sc::now();
+        sm::hdfdata::frame_reader<float> pass (data, "/sim/hexvals");
+        for (const float* fp = pass.next(); fp != nullptr; fp = pass.next()) { sum += fp[0]; }
+        sc::duration t_stream = sc::now() - t0;
+        if (nread != nf1 + nf2 || nwrong > 0) {
+            std::cout << "Fail: frame_reader read " << nread << " frames, " << nwrong << " of them wrong\n";
+            --rtn;
+        }
+
+        // Stream a range of hexes in small blocks, starting part way through
+        sm::hdfdata::frame_reader<float> hexrange (data, "/sim/hexvals", 7, 500, 20);
+        hexrange.seek (100);
+        nwrong = 0;
+        for (const float* fp = hexrange.next(); fp != nullptr; fp = hexrange.next()) {
+            const unsigned int i = static_cast<unsigned int>(hexrange.position() - 1);
+            for (unsigned int j = 0; j < 20; ++j) { if (fp[j] != val (i, 500 + j)) { ++nwrong; } }
+        }
+        if (hexrange.position() != nf1 + nf2 || hexrange.frame_size() != 20 || nwrong > 0) {
+            std::cout << "Fail: frame_reader of a range of hexes\n";
+            --rtn;
+        }
+
+        // For comparison, read all the frames at once
+        t0 = sc::now();
+        data.read_frames ("/sim/hexvals", 0, nf1 + nf2, f);
+        sc::duration t_all = sc::now() - t0;
+
+        std::cout << nf1 + nf2 << " frames of " << n << " values: compressed file " << sz / 1024
+                  << " KB (uncompressed " << sz_raw / 1024 << " KB)\n"
+                  << "  streamed in blocks of " << frames.frames_per_block() << " frames: "
+                  << duration_cast<microseconds>(t_stream).count() << " us\n"
+                  << "  read at once: " << duration_cast<microseconds>(t_all).count() << " us (checksum "
+                  << sum << ")\n";
+    }
+
+    std::remove (fname);
+    std::remove (fname_raw);
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,178 @@
+/*
+ * Test hexgrid::convolve against the original, list-walking implementation (reproduced
+ * below) and profile the two on large grids.
+ */
+#include <iostream>
+#include <vector>
+#include <list>
+#include <cmath>
+#include <chrono>
+
+#include <sm/hexgrid>
+#include <sm/random>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// The original hexgrid::convolve, which walks the neighbour relations of the std::list<hex>
+// for every kernel hex and every domain hex.
+template<typename T>
+void convolve_walk (sm::hexgrid& hg, const sm::hexgrid& kernelgrid, const std::vector<T>& kerneldata,
+                    const std::vector<T>& data, std::vector<T>& result)
+{
+    for (auto hi = hg.hexen.begin(); hi != hg.hexen.end(); ++hi) {
+        T sum = T{0};
+        for (auto kh : kernelgrid.hexen) {
+            std::list<sm::hex>::iterator dhi = hi;
+            int rr = kh.ri;
+            int gg = kh.gi;
+            bool failed = false;
+            while (true) {
+                bool moved = false;
+                if (rr > 0) {
+                    if (dhi->has_ne()) { dhi = dhi->ne; --rr; moved = true; }
+                } else if (rr < 0) {
+                    if (dhi->has_nw()) { dhi = dhi->nw; ++rr; moved = true; }
+                }
+                if (gg > 0) {
+                    if (dhi->has_nne()) { dhi = dhi->nne; --gg; moved = true; }
+                } else if (gg < 0) {
+                    if (dhi->has_nsw()) { dhi = dhi->nsw; ++gg; moved = true; }
+                }
+                if (rr == 0 && gg == 0) { break; }
+                if (!moved) { failed = true; break; }
+            }
+            if (!failed) { sum += data[dhi->vi] * kerneldata[kh.vi]; }
+        }
+        result[hi->vi] = sum;
+    }
+}
+
+// Convolve random data on the domain hg with both methods. Return the number of mismatches.
+int compare (sm::hexgrid& hg, const sm::hexgrid& kernel, const std::vector<float>& kerneldata, const bool profile_walk)
+{
+    sm::rand_uniform<float> rng (0.0f, 1.0f, 1234);
+    std::vector<float> data = rng.get (hg.num());
+    std::vector<float> result_walk (hg.num(), 0.0f);
+    std::vector<float> result (hg.num(), 0.0f);
+
+    if (profile_walk) {
+        sc::time_point t0 = sc::now();
+        convolve_walk (hg, kernel, kerneldata, data, result_walk);
+        sc::duration t = sc::now() - t0;
+        std::cout << "  Neighbour walk convolution:      " << duration_cast<milliseconds>(t).count() << " ms\n";
+    }
+
+    sc::time_point t0 = sc::now();
+    hg.convolve (kernel, kerneldata, data, result);
+    sc::duration t_first = sc::now() - t0;
+    t0 = sc::now();
+    hg.convolve (kernel, kerneldata, data, result);
+    sc::duration t_second = sc::now() - t0;
+    std::cout << "  hexgrid::convolve (first call):  " << duration_cast<milliseconds>(t_first).count() << " ms\n";
+    std::cout << "  hexgrid::convolve (cached plan): " << duration_cast<microseconds>(t_second).count() << " us\n";
+
+    int mismatches = 0;
+    if (profile_walk) {
+        for (unsigned int i = 0; i < hg.num(); ++i) {
+            if (std::abs (result[i] - result_walk[i]) > 1e-5f) { ++mismatches; }
+        }
+        if (mismatches) { std::cout << "  " << mismatches << " results differ from the neighbour walk\n"; }
+    }
+    return mismatches;
+}
+
+// Compare the two methods on a circular domain of the given radius
+int compare (const float radius, const sm::hexgrid& kernel, const std::vector<float>& kerneldata, const bool profile_walk)
+{
+    sm::hexgrid hg (0.01f, 4.0f * radius + 0.5f, 0.0f);
+    hg.setCircularBoundary (radius);
+    std::cout << "Domain of radius " << radius << " has " << hg.num() << " hexes\n";
+    return compare (hg, kernel, kerneldata, profile_walk);
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // A Gaussian kernel
+    constexpr float sigma = 0.025f;
+    sm::hexgrid kernel (0.01f, 20.0f * sigma, 0.0f);
+    kernel.setCircularBoundary (3.0f * sigma);
+    std::vector<float> kerneldata (kernel.num(), 0.0f);
+    float ksum = 0.0f;
+    for (auto k : kernel.hexen) {
+        kerneldata[k.vi] = std::exp (-(k.x * k.x + k.y * k.y) / (2.0f * sigma * sigma));
+        ksum += kerneldata[k.vi];
+    }
+    for (auto& k : kerneldata) { k /= ksum; }
+    std::cout << "Kernel has " << kernel.num() << " hexes\n";
+
+    // A domain smaller than the kernel, so that every hex is an 'edge' hex
+    if (compare (0.05f, kernel, kerneldata, true) != 0) { --rtn; }
+    // About 20,000 hexes
+    if (compare (0.75f, kernel, kerneldata, true) != 0) { --rtn; }
+    // About 100,000 hexes
+    if (compare (1.7f, kernel, kerneldata, true) != 0) { --rtn; }
+
+    // A parallelogram domain with wrapped boundaries. The neighbour walk crosses the
+    // boundaries, so the plan must follow the neighbour relations rather than the lattice.
+    {
+        sm::hexgrid hgw (0.01f, 3.0f, 0.0f);
+        hgw.setParallelogramBoundary (40, 30);
+        hgw.setParallelogramWrap (true, true);
+        std::cout << "Wrapped parallelogram domain has " << hgw.num() << " hexes\n";
+        if (compare (hgw, kernel, kerneldata, true) != 0) { --rtn; }
+        // With wrapping, every hex sees the whole (normalised) kernel
+        std::vector<float> ones (hgw.num(), 1.0f);
+        std::vector<float> rw (hgw.num(), 0.0f);
+        hgw.convolve (kernel, kerneldata, ones, rw);
+        for (auto r : rw) {
+            if (std::abs (r - 1.0f) > 1e-4f) { std::cout << "Wrapped convolution of ones gave " << r << std::endl; --rtn; break; }
+        }
+        // And the same grid without wrapping
+        sm::hexgrid hgu (0.01f, 3.0f, 0.0f);
+        hgu.setParallelogramBoundary (40, 30);
+        std::cout << "Unwrapped parallelogram domain has " << hgu.num() << " hexes\n";
+        if (compare (hgu, kernel, kerneldata, true) != 0) { --rtn; }
+    }
+
+    // A plan is cached per kernel. A differently sized kernel must give a new plan.
+    sm::hexgrid kernel2 (0.01f, 20.0f * sigma, 0.0f);
+    kernel2.setCircularBoundary (1.5f * sigma);
+    std::vector<float> kerneldata2 (kernel2.num(), 1.0f);
+    sm::hexgrid hg (0.01f, 1.0f, 0.0f);
+    hg.setCircularBoundary (0.3f);
+    std::vector<float> data (hg.num(), 1.0f);
+    std::vector<float> r1 (hg.num(), 0.0f);
+    std::vector<float> r2 (hg.num(), 0.0f);
+    hg.convolve (kernel, kerneldata, data, r1);
+    hg.convolve (kernel2, kerneldata2, data, r2);
+    convolve_walk (hg, kernel2, kerneldata2, data, r1);
+    for (unsigned int i = 0; i < hg.num(); ++i) {
+        if (r1[i] != r2[i]) { std::cout << "Second kernel gave wrong result\n"; --rtn; break; }
+    }
+
+    // Only the most recently used plans are kept. Convolve with more kernels than that, then
+    // check that the number of plans is capped and that the results are still right.
+    for (unsigned int kr = 1; kr <= 2 * sm::hexgrid::max_convolution_plans; ++kr) {
+        sm::hexgrid kn (0.01f, 20.0f * sigma, 0.0f);
+        kn.setCircularBoundary (0.01f * kr);
+        std::vector<float> kd (kn.num(), 1.0f);
+        hg.convolve (kn, kd, data, r1);
+        convolve_walk (hg, kn, kd, data, r2);
+        if (r1 != r2) { std::cout << "Kernel " << kr << " gave wrong result\n"; --rtn; }
+        // The most recent kernel re-uses its plan
+        hg.convolve (kn, kd, data, r1);
+    }
+    if (hg.numConvolutionPlans() != sm::hexgrid::max_convolution_plans) {
+        std::cout << hg.numConvolutionPlans() << " convolution plans held; expected "
+                  << sm::hexgrid::max_convolution_plans << std::endl;
+        --rtn;
+    }
+    hg.clearConvolutionPlans();
+    if (hg.numConvolutionPlans() != 0u) { std::cout << "clearConvolutionPlans left plans\n"; --rtn; }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
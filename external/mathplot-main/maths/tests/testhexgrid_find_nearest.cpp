@@ -0,0 +1,103 @@
+/*
+ * Test the lookup index behind hexgrid::find_nearest and findHexNearest against a linear
+ * search and profile lookups on grids of 1e4 to 1e6 hexes.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <limits>
+
+#include <sm/hexgrid>
+#include <sm/random>
+#include <sm/vvec>
+#include <sm/vec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// The distance from pos to the nearest hex, by linear search of the d_ vectors
+float nearest_dist_linear (const sm::hexgrid& hg, const sm::vec<float, 2>& pos)
+{
+    float dist = std::numeric_limits<float>::max();
+    for (unsigned int i = 0; i < hg.d_x.size(); ++i) {
+        dist = std::min (dist, (pos - sm::vec<float, 2>{ hg.d_x[i], hg.d_y[i] }).length());
+    }
+    return dist;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    sm::rand_uniform<float> rng (0.0f, 1.0f, 2468);
+
+    for (float radius : { 0.55f, 1.7f, 5.4f }) {
+        sm::hexgrid hg (0.01f, 2.2f * radius + 0.1f, 0.0f);
+        hg.setCircularBoundary (radius);
+
+        // Query positions within a circle 10% larger than the grid, so that some lie outside
+        // the boundary (where the bucketed search is used)
+        constexpr unsigned int nq = 1000000;
+        sm::vvec<sm::vec<float, 2>> queries (nq);
+        for (auto& q : queries) {
+            do {
+                q = { (rng.get() - 0.5f) * 2.2f * radius, (rng.get() - 0.5f) * 2.2f * radius };
+            } while (q.length() > 1.1f * radius);
+        }
+
+        // The index is built on first use
+        sc::time_point t0 = sc::now();
+        hg.find_nearest (queries[0]);
+        sc::duration t_build = sc::now() - t0;
+
+        t0 = sc::now();
+        sm::vvec<int> nearest = hg.find_nearest (queries);
+        sc::duration t_batch = sc::now() - t0;
+
+        // Linear search with the original findHexNearest algorithm for a few of the queries
+        constexpr unsigned int nlin = 200;
+        t0 = sc::now();
+        for (unsigned int i = 0; i < nlin; ++i) {
+            float d = nearest_dist_linear (hg, queries[i]);
+            int ni = nearest[i];
+            float d_idx = (queries[i] - sm::vec<float, 2>{ hg.d_x[ni], hg.d_y[ni] }).length();
+            if (std::abs (d - d_idx) > 1e-6f) {
+                std::cout << "Fail: query " << i << " found a hex at " << d_idx << " not " << d << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        sc::duration t_lin = sc::now() - t0;
+
+        // findHexNearest now uses the index and must agree with find_nearest
+        for (unsigned int i = 0; i < 1000; ++i) {
+            if (hg.findHexNearest (queries[i])->di != static_cast<unsigned int>(nearest[i])) {
+                std::cout << "Fail: findHexNearest and find_nearest disagree\n";
+                --rtn;
+                break;
+            }
+        }
+
+        // Each hex centre is in its own hex; points outside the grid are in no hex
+        for (unsigned int i = 0; i < hg.d_x.size(); i += 97) {
+            if (hg.find_hex_at ({ hg.d_x[i], hg.d_y[i] }) != static_cast<int>(i)) {
+                std::cout << "Fail: find_hex_at did not find hex " << i << std::endl;
+                --rtn;
+                break;
+            }
+        }
+        if (hg.find_hex_at ({ 2.0f * radius, 0.0f }) != -1) { std::cout << "Fail: find_hex_at outside grid\n"; --rtn; }
+
+        std::cout << hg.num() << " hexes:\n"
+                  << "  index build:            " << duration_cast<microseconds>(t_build).count() << " us\n"
+                  << "  linear search:          " << duration_cast<nanoseconds>(t_lin).count() / nlin << " ns per query\n"
+                  << "  find_nearest (batch):   " << duration_cast<nanoseconds>(t_batch).count() / nq << " ns per query\n";
+    }
+
+    // A grid with no d_ vectors has nothing to index
+    sm::hexgrid hg_noboundary (0.1f, 1.0f, 0.0f);
+    if (hg_noboundary.find_nearest (sm::vec<float, 2>{ 0.0f, 0.0f }) != -1) { --rtn; }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
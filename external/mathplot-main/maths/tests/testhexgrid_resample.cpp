@@ -0,0 +1,79 @@
+/*
+ * Test hexgrid::resampleImage (which uses sm::imageresampler) against a brute force resampling
+ * that visits every image pixel for every hex, with and without cached weights, and check that
+ * the cached weights are dropped when the hexgrid's d_ vectors are cleared.
+ */
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include <sm/hexgrid>
+#include <sm/vvec>
+#include <sm/vec>
+
+// Every pixel within 3 sigma (in x and y) of each target, weighted by a 2D Gaussian
+sm::vvec<float> brute_force (const std::vector<float>& tx, const std::vector<float>& ty,
+                             const sm::vvec<float>& image_data, const unsigned int w,
+                             const sm::vec<float, 2>& image_scale, const sm::vec<float, 2>& image_offset)
+{
+    const unsigned int h = image_data.size() / w;
+    sm::vec<unsigned int, 2> image_pixelsz = { w, h };
+    sm::vec<float, 2> dist_per_pix = image_scale / (w - 1u);
+    sm::vec<float, 2> input_centering_offset = dist_per_pix * image_pixelsz * 0.5f;
+    sm::vec<float, 2> params = 1.0f / (2.0f * dist_per_pix * dist_per_pix);
+    sm::vec<float, 2> threesig = 3.0f * dist_per_pix;
+
+    sm::vvec<float> result (tx.size(), 0.0f);
+    for (unsigned int xi = 0; xi < tx.size(); ++xi) {
+        for (unsigned int i = 0; i < image_data.size(); ++i) {
+            sm::vec<unsigned int, 2> idx = { i % w, i / w };
+            sm::vec<float, 2> posn = (dist_per_pix * idx) - input_centering_offset + image_offset;
+            float dx = tx[xi] - posn[0];
+            float dy = ty[xi] - posn[1];
+            if (std::abs (dx) < threesig[0] && std::abs (dy) < threesig[1]) {
+                result[xi] += std::exp (-((params[0] * dx * dx) + (params[1] * dy * dy))) * image_data[i];
+            }
+        }
+    }
+    result /= result.max();
+    return result;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    sm::hexgrid hg (0.04f, 3.0f, 0.0f);
+    hg.setCircularBoundary (0.8f);
+    constexpr unsigned int w = 150;
+    constexpr unsigned int h = 110;
+    sm::vvec<float> image_data (w * h, 0.0f);
+    image_data.randomize();
+    sm::vec<float, 2> image_scale = { 1.8f, 1.8f };
+    sm::vec<float, 2> image_offset = { -0.05f, 0.1f };
+
+    sm::vvec<float> bf = brute_force (hg.d_x, hg.d_y, image_data, w, image_scale, image_offset);
+    sm::vvec<float> rs = hg.resampleImage (image_data, w, image_scale, image_offset);
+    sm::vvec<float> rs_cached = hg.resampleImage (image_data, w, image_scale, image_offset, true);
+    // A second call uses the cached weights
+    sm::vvec<float> rs_cached2 = hg.resampleImage (image_data, w, image_scale, image_offset, true);
+
+    float maxdiff = (bf - rs).abs().max();
+    float maxdiff_cached = std::max ((bf - rs_cached).abs().max(), (bf - rs_cached2).abs().max());
+    std::cout << hg.num() << " hexes; max difference from brute force: " << maxdiff
+              << " (cached weights: " << maxdiff_cached << ")\n";
+    if (maxdiff > 1e-5f || maxdiff_cached > 1e-5f) { std::cout << "Fail: differs from brute force\n"; --rtn; }
+
+    // Move the hexes and rebuild the d_ vectors, keeping the number of hexes and the image size,
+    // scale and offset the same. The cached weights are now wrong, so d_clear() must drop them.
+    for (auto& hx : hg.hexen) { hx.x += 0.13f; hx.y -= 0.07f; }
+    hg.populate_d_vectors(); // calls d_clear()
+    bf = brute_force (hg.d_x, hg.d_y, image_data, w, image_scale, image_offset);
+    rs_cached = hg.resampleImage (image_data, w, image_scale, image_offset, true);
+    maxdiff_cached = (bf - rs_cached).abs().max();
+    std::cout << "After moving the hexes, max difference from brute force: " << maxdiff_cached << "\n";
+    if (maxdiff_cached > 1e-5f) { std::cout << "Fail: cached weights survived d_clear()\n"; --rtn; }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,121 @@
+/*
+ * Test sm::imageresampler (via cartgrid::resampleImage) against a brute force resampling
+ * that visits every image pixel for every element, and profile the on-the-fly and cached
+ * weight matrix resampling of a camera-sized image.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+
+#include <sm/cartgrid>
+#include <sm/imageresampler>
+#include <sm/vvec>
+#include <sm/vec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// Every pixel within 3 sigma (in x and y) of each target, weighted by a 2D Gaussian
+sm::vvec<float> brute_force (const std::vector<float>& tx, const std::vector<float>& ty,
+                             const sm::vvec<float>& image_data, const unsigned int w,
+                             const sm::vec<float, 2>& image_scale, const sm::vec<float, 2>& image_offset)
+{
+    const unsigned int h = image_data.size() / w;
+    sm::vec<unsigned int, 2> image_pixelsz = { w, h };
+    sm::vec<float, 2> dist_per_pix = image_scale / (w - 1u);
+    sm::vec<float, 2> input_centering_offset = dist_per_pix * image_pixelsz * 0.5f;
+    sm::vec<float, 2> params = 1.0f / (2.0f * dist_per_pix * dist_per_pix);
+    sm::vec<float, 2> threesig = 3.0f * dist_per_pix;
+
+    sm::vvec<float> result (tx.size(), 0.0f);
+    for (unsigned int xi = 0; xi < tx.size(); ++xi) {
+        for (unsigned int i = 0; i < image_data.size(); ++i) {
+            sm::vec<unsigned int, 2> idx = { i % w, i / w };
+            sm::vec<float, 2> posn = (dist_per_pix * idx) - input_centering_offset + image_offset;
+            float dx = tx[xi] - posn[0];
+            float dy = ty[xi] - posn[1];
+            if (std::abs (dx) < threesig[0] && std::abs (dy) < threesig[1]) {
+                result[xi] += std::exp (-((params[0] * dx * dx) + (params[1] * dy * dy))) * image_data[i];
+            }
+        }
+    }
+    result /= result.max();
+    return result;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // Compare with the brute force method on a small image
+    {
+        sm::cartgrid cg (0.05f, 2.0f);
+        cg.setBoundaryOnOuterEdge();
+        constexpr unsigned int w = 160;
+        constexpr unsigned int h = 120;
+        sm::vvec<float> image_data (w * h, 0.0f);
+        image_data.randomize();
+        sm::vec<float, 2> image_scale = { 1.6f, 1.6f };
+        sm::vec<float, 2> image_offset = { 0.1f, -0.05f };
+
+        sm::vvec<float> bf = brute_force (cg.d_x, cg.d_y, image_data, w, image_scale, image_offset);
+        sm::vvec<float> rs = cg.resampleImage (image_data, w, image_scale, image_offset);
+        sm::vvec<float> rs_cached = cg.resampleImage (image_data, w, image_scale, image_offset, true);
+
+        float maxdiff = (bf - rs).abs().max();
+        float maxdiff_cached = (bf - rs_cached).abs().max();
+        std::cout << cg.num() << " elements; max difference from brute force: " << maxdiff
+                  << " (cached weights: " << maxdiff_cached << ")\n";
+        if (maxdiff > 1e-5f || maxdiff_cached > 1e-5f) { std::cout << "Fail: differs from brute force\n"; --rtn; }
+    }
+
+    // Resampling with cached weights must follow changes in the image geometry
+    {
+        sm::cartgrid cg (0.05f, 2.0f);
+        cg.setBoundaryOnOuterEdge();
+        constexpr unsigned int w = 100;
+        sm::vvec<float> image_data (w * w, 0.0f);
+        image_data.randomize();
+        sm::vec<float, 2> image_offset = { 0.0f, 0.0f };
+        cg.resampleImage (image_data, w, { 1.0f, 1.0f }, image_offset, true);
+        sm::vvec<float> rs_cached = cg.resampleImage (image_data, w, { 1.5f, 1.5f }, image_offset, true);
+        sm::vvec<float> rs = cg.resampleImage (image_data, w, { 1.5f, 1.5f }, image_offset);
+        if ((rs_cached - rs).abs().max() > 1e-5f) { std::cout << "Fail: cached weights were not recomputed for a new image_scale\n"; --rtn; }
+    }
+
+    // Profile resampling of a camera frame onto a 40,000 element grid
+    {
+        sm::cartgrid cg (0.01f, 2.0f);
+        cg.setBoundaryOnOuterEdge();
+        constexpr unsigned int w = 640;
+        constexpr unsigned int h = 480;
+        sm::vvec<float> image_data (w * h, 0.0f);
+        image_data.randomize();
+        sm::vec<float, 2> image_scale = { 2.0f, 2.0f };
+        sm::vec<float, 2> image_offset = { 0.0f, 0.0f };
+
+        sc::time_point t0 = sc::now();
+        sm::vvec<float> rs = cg.resampleImage (image_data, w, image_scale, image_offset);
+        sc::duration t_otf = sc::now() - t0;
+
+        t0 = sc::now();
+        sm::vvec<float> rs_cached = cg.resampleImage (image_data, w, image_scale, image_offset, true);
+        sc::duration t_first = sc::now() - t0;
+
+        constexpr int nframes = 20;
+        t0 = sc::now();
+        for (int f = 0; f < nframes; ++f) {
+            image_data[f] += 0.5f; // defeat the all-the-same short cut in a realistic way
+            rs_cached = cg.resampleImage (image_data, w, image_scale, image_offset, true);
+        }
+        sc::duration t_frames = sc::now() - t0;
+
+        std::cout << w << "x" << h << " image onto " << cg.num() << " elements:\n"
+                  << "  on-the-fly weights:             " << duration_cast<microseconds>(t_otf).count() << " us\n"
+                  << "  computing and caching weights:  " << duration_cast<microseconds>(t_first).count() << " us\n"
+                  << "  cached weights (per frame):     " << duration_cast<microseconds>(t_frames).count() / nframes << " us\n";
+    }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,190 @@
+/*
+ * Profile vvec's reductions, in-place pruning and lazy expressions against the implementations
+ * that they replaced (reproduced here), checking that the results agree.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <sm/vvec>
+#include <sm/vvec_expr>
+#include <sm/random>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// The previous implementations
+float old_sum (const sm::vvec<float>& v) { return std::accumulate (v.begin(), v.end(), 0.0f); }
+float old_sos (const sm::vvec<float>& v) { return std::accumulate (v.begin(), v.end(), 0.0f, [](float a, float b) { return a + b * b; }); }
+float old_max (const sm::vvec<float>& v)
+{
+    auto themax = std::max_element (v.begin(), v.end());
+    return themax == v.end() ? 0.0f : *themax;
+}
+void old_prune_positive_inplace (sm::vvec<float>& v)
+{
+    sm::vvec<float> pruned;
+    for (auto& i : v) { if (i <= 0.0f) { pruned.push_back (i); } }
+    v.swap (pruned);
+}
+
+// Time f over nrep repetitions, returning microseconds per repetition
+template <typename F>
+double time_us (const int nrep, F f)
+{
+    sc::time_point t0 = sc::now();
+    for (int r = 0; r < nrep; ++r) { f(); }
+    return duration_cast<nanoseconds>(sc::now() - t0).count() / (1000.0 * nrep);
+}
+
+void report (const char* what, const double t_old, const double t_new)
+{
+    std::cout << "  " << what << ": " << t_old << " us -> " << t_new << " us (x" << (t_new > 0.0 ? t_old / t_new : 0.0) << ")\n";
+}
+
+// Relative difference of a and b
+double reldiff (const double a, const double b) { return std::abs (a - b) / std::max (std::abs (a), 1.0); }
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr std::size_t n = 1000000;
+    constexpr int nrep = 20;
+    sm::vvec<float> a (n);
+    sm::vvec<float> b (n);
+    sm::vvec<float> c (n);
+    a.randomize (-1.0f, 1.0f);
+    b.randomize (-1.0f, 1.0f);
+    c.randomize (-1.0f, 1.0f);
+    // An exact sum in double precision
+    const double exact = std::accumulate (a.begin(), a.end(), 0.0);
+    const double exact_sos = std::accumulate (a.begin(), a.end(), 0.0, [](double s, float x) { return s + double{x} * x; });
+
+    volatile float sink = 0.0f;
+    std::cout << "vvec<float> of " << n << " elements, old -> new:\n";
+
+    // Reductions
+    if (reldiff (a.sum(), exact) > 1e-4 || reldiff (a.sos(), exact_sos) > 1e-5 || reldiff (a.mean(), exact / n) > 1e-4) {
+        std::cout << "Fail: sum " << a.sum() << ", sos " << a.sos() << " or mean " << a.mean() << " differ from "
+                  << exact << ", " << exact_sos << ", " << exact / n << std::endl;
+        --rtn;
+    }
+    report ("sum", time_us (nrep, [&]() { sink = sink + old_sum (a); }), time_us (nrep, [&]() { sink = sink + a.sum(); }));
+    report ("sos", time_us (nrep, [&]() { sink = sink + old_sos (a); }), time_us (nrep, [&]() { sink = sink + a.sos(); }));
+    if (a.max() != old_max (a)) { std::cout << "Fail: max " << a.max() << " != " << old_max (a) << std::endl; --rtn; }
+    report ("max", time_us (nrep, [&]() { sink = sink + old_max (a); }), time_us (nrep, [&]() { sink = sink + a.max(); }));
+
+    // The threaded result (if compiled with OpenMP) is identical to the serial one
+    const float s_par = a.sum();
+    const float m_par = a.max();
+    const std::size_t prs = sm::vvec<float>::parallel_reduce_size;
+    sm::vvec<float>::parallel_reduce_size = std::numeric_limits<std::size_t>::max();
+    if (a.sum() != s_par || a.max() != m_par) { std::cout << "Fail: threaded and serial reductions differ\n"; --rtn; }
+    sm::vvec<float>::parallel_reduce_size = prs;
+
+    // Integer sums are exact, however the elements are grouped
+    sm::vvec<int> iv (n + 13);
+    iv.randomize (-1000, 1000);
+    if (iv.sum() != std::accumulate (iv.begin(), iv.end(), 0)) { std::cout << "Fail: integer sum\n"; --rtn; }
+    sm::vvec<unsigned char> uv (300, 10);
+    if (uv.sum<false, unsigned int>() != 3000u) { std::cout << "Fail: sum of uchar into unsigned int\n"; --rtn; }
+
+    // max treats NaN as std::max_element does
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    sm::vvec<float> hasnan = { 3.0f, nan, 7.0f, 1.0f, nan, 2.0f, 5.0f, 4.0f, 9.0f, 0.0f, nan };
+    if (hasnan.max() != 9.0f) { std::cout << "Fail: max with NaNs is " << hasnan.max() << std::endl; --rtn; }
+    hasnan[0] = nan;
+    if (!std::isnan (hasnan.max()) || !std::isnan (old_max (hasnan))) { std::cout << "Fail: max with NaN first\n"; --rtn; }
+    if (hasnan.sum<true>() != 28.0f || hasnan.mean<true>() != 4.0f) {
+        std::cout << "Fail: sum/mean ignoring NaNs: " << hasnan.sum<true>() << "/" << hasnan.mean<true>() << std::endl;
+        --rtn;
+    }
+    if (sm::vvec<float>{}.max() != 0.0f || sm::vvec<float>{}.sum() != 0.0f) { std::cout << "Fail: empty reductions\n"; --rtn; }
+
+    // Pruning in place
+    {
+        sm::vvec<float> p1 = a;
+        p1[5] = nan;
+        p1[6] = -0.0f;
+        sm::vvec<float> p2 = p1;
+        sm::vvec<float> p3 = p1;
+        const double t_old = time_us (1, [&]() { old_prune_positive_inplace (p1); });
+        const double t_new = time_us (1, [&]() { p2.prune_positive_inplace(); });
+        if (p1 != p2 || p2 != p3.prune_positive()) { std::cout << "Fail: prune_positive_inplace\n"; --rtn; }
+        report ("prune_positive_inplace", t_old, t_new);
+
+        sm::vvec<float> q = { 0.0f, nan, 4.0f, -3.0f, -0.0f, 8.8f, nan, -7.0f };
+        sm::vvec<float> q1 = q;
+        q1.prune_negative_inplace();
+        if (q1 != sm::vvec<float>{ 0.0f, 4.0f, -0.0f, 8.8f }) { std::cout << "Fail: prune_negative_inplace " << q1 << std::endl; --rtn; }
+        sm::vvec<float> q2 = q;
+        q2.prune_nan_inplace();
+        if (q2 != sm::vvec<float>{ 0.0f, 4.0f, -3.0f, -0.0f, 8.8f, -7.0f }) { std::cout << "Fail: prune_nan_inplace " << q2 << std::endl; --rtn; }
+        q2.prune_zero_inplace();
+        if (q2 != sm::vvec<float>{ 4.0f, -3.0f, 8.8f, -7.0f }) { std::cout << "Fail: prune_zero_inplace " << q2 << std::endl; --rtn; }
+    }
+
+    // Lazy expressions
+    {
+        sm::vvec<float> r_old = a * b + c;
+        sm::vvec<float> r_new = sm::lazy (a) * b + c;
+        if ((r_new - r_old).abs().max() > 1e-6f) { std::cout << "Fail: lazy a * b + c\n"; --rtn; }
+        report ("r = a * b + c", time_us (nrep, [&]() { r_old = a * b + c; }),
+                time_us (nrep, [&]() { (sm::lazy (a) * b + c).eval_to (r_new); }));
+
+        const float* mem = r_new.data();
+        (2.0f * sm::lazy (a) - b / 4.0f).eval_to (r_new);
+        if (r_new.data() != mem) { std::cout << "Fail: eval_to did not re-use the destination\n"; --rtn; }
+        if ((r_new - (a * 2.0f - b / 4.0f)).abs().max() > 1e-6f) { std::cout << "Fail: lazy 2a - b/4\n"; --rtn; }
+
+        // The destination may be one of the operands
+        sm::vvec<float> d = a;
+        (sm::lazy (d) * d + 1.0f).eval_to (d);
+        if ((d - (a * a + 1.0f)).abs().max() > 1e-6f) { std::cout << "Fail: lazy d = d * d + 1\n"; --rtn; }
+
+        sm::vvec<float> p_old = a.pow (3);
+        sm::vvec<float> p_new = sm::lazy (a).pow<3>();
+        if ((p_new - p_old).abs().max() > 1e-6f) { std::cout << "Fail: lazy pow<3>\n"; --rtn; }
+        report ("a.pow (3)", time_us (nrep, [&]() { p_old = a.pow (3); }),
+                time_us (nrep, [&]() { sm::lazy (a).pow<3>().eval_to (p_new); }));
+
+        sm::vvec<float> e_old = (a * 0.5f).exp() + b;
+        sm::vvec<float> e_new = (sm::lazy (a) * 0.5f).exp() + b;
+        if ((e_new - e_old).abs().max() > 1e-6f) { std::cout << "Fail: lazy exp\n"; --rtn; }
+        report ("(a * 0.5).exp() + b", time_us (nrep, [&]() { e_old = (a * 0.5f).exp() + b; }),
+                time_us (nrep, [&]() { ((sm::lazy (a) * 0.5f).exp() + b).eval_to (e_new); }));
+
+        // Reductions of expressions need no storage at all
+        const float d_old = (a - b).sos();
+        const float d_new = (sm::lazy (a) - b).sos();
+        if (reldiff (d_new, d_old) > 1e-6) { std::cout << "Fail: lazy (a - b).sos() " << d_new << " != " << d_old << std::endl; --rtn; }
+        if ((sm::lazy (a) * b).sum() != (a * b).sum() || (-sm::lazy (a)).max() != (-a).max()) {
+            std::cout << "Fail: lazy sum/max\n";
+            --rtn;
+        }
+        report ("(a - b).sos()", time_us (nrep, [&]() { sink = sink + (a - b).sos(); }),
+                time_us (nrep, [&]() { sink = sink + (sm::lazy (a) - b).sos(); }));
+
+        // Mixed value types give the common type
+        sm::vvec<double> dv (n, 0.5);
+        sm::vvec<double> mixed = sm::lazy (a) + dv;
+        if (std::abs (mixed[7] - (double{a[7]} + 0.5)) > 1e-12) { std::cout << "Fail: mixed float/double\n"; --rtn; }
+
+        // Operands must have the same size
+        bool threw = false;
+        sm::vvec<float> shorter (10, 1.0f);
+        try {
+            sm::vvec<float> bad = sm::lazy (a) + shorter;
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) { std::cout << "Fail: operands of different sizes did not throw\n"; --rtn; }
+    }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
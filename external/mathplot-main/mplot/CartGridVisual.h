@@ -113,6 +113,63 @@ namespace mplot {
             }
         }
 
+        /*!
+         * Update the model after the data has changed, re-computing and uploading only the
+         * vertex buffers that depend on the data (the indices never change). If the z values
+         * of the rects are unchanged (as when zScale is flat), then only the colours are
+         * re-computed and uploaded. A full reinit() is made if the model has not been built yet.
+         */
+        void reinit_on_update()
+        {
+            const std::size_t nrect = this->cg->num();
+            const std::size_t verts_per_rect = this->cartVisMode == CartVisMode::Triangles ? 1u : 5u;
+            this->determine_datasize();
+            if (this->datasize != nrect || this->vertexColors.size() < 3u * verts_per_rect * nrect) {
+                VisualDataModel<T, glver>::reinit();
+                return;
+            }
+
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            this->setupScaling();
+
+            if (static_cast<const std::vector<float>&>(this->dcopy) == this->built_z) {
+                // Only the colours have changed. Border vertices follow the rects and are left as they are.
+                this->computeColours (this->rectcolours);
+                const int n = static_cast<int>(nrect);
+                const int vpr = static_cast<int>(verts_per_rect);
+                float* vc = this->vertexColors.data();
+                const float* rc = this->rectcolours.data();
+#pragma omp parallel for
+                for (int ri = 0; ri < n; ++ri) {
+                    for (int v = 0; v < vpr; ++v) {
+                        vc[3 * (vpr * ri + v)] = rc[3 * ri];
+                        vc[3 * (vpr * ri + v) + 1] = rc[3 * ri + 1];
+                        vc[3 * (vpr * ri + v) + 2] = rc[3 * ri + 2];
+                    }
+                }
+            } else {
+                // Re-compute the vertices, but upload only positions, normals and colours
+                this->vertexPositions.clear();
+                this->vertexNormals.clear();
+                this->vertexColors.clear();
+                this->indices.clear();
+                this->initializeVertices();
+                this->reinit_position_buffer();
+                this->reinit_normal_buffer();
+            }
+
+            this->reinit_colour_buffer();
+        }
+
+        using VisualDataModel<T, glver>::updateData;
+
+        //! Update the scalar data, re-uploading only the vertex buffers that change (see reinit_on_update)
+        void updateData (const std::vector<T>* _data)
+        {
+            this->scalarData = _data;
+            this->reinit_on_update();
+        }
+
         // Initialize vertex buffer objects and vertex array object.
 
         //! Initialize as a minimal, triangled surface
@@ -122,9 +179,11 @@ namespace mplot {
             unsigned int nrect = this->cg->num();
 
             this->setupScaling();
+            this->computeColours (this->rectcolours);
+            this->built_z = this->dcopy;
 
             for (unsigned int ri = 0; ri < nrect; ++ri) {
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = { this->rectcolours[3u * ri], this->rectcolours[3u * ri + 1], this->rectcolours[3u * ri + 2] };
                 this->vertex_push (this->cg->d_x[ri]+centering_offset[0],
                                    this->cg->d_y[ri]+centering_offset[1], this->dcopy[ri], this->vertexPositions);
                 this->vertex_push (clr, this->vertexColors);
@@ -166,6 +225,8 @@ namespace mplot {
             this->idx = 0;
 
             this->setupScaling();
+            this->computeColours (this->rectcolours);
+            this->built_z = this->dcopy;
 
             float datumC = 0.0f;   // datum at the centre
             float datumNE = 0.0f;  // datum at the hex to the east.
@@ -197,7 +258,7 @@ namespace mplot {
 
                 // Use a single colour for each rect, even though rectangle's z
                 // positions are interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = { this->rectcolours[3u * ri], this->rectcolours[3u * ri + 1], this->rectcolours[3u * ri + 2] };
 
                 // First push the 5 positions of the triangle vertices, starting with the centre
                 this->vertex_push (this->cg->d_x[ri]+centering_offset[0], this->cg->d_y[ri]+centering_offset[1], datumC, this->vertexPositions);
@@ -421,6 +482,12 @@ namespace mplot {
         // computed so that you *add* centering_offset to each computed x/y/z position
         // for a rectangle.
         sm::vec<float, 3> centering_offset = { 0.0f, 0.0f, 0.0f };
+
+        //! The colour of each rect, computed by a batch ColourMap conversion of dcolour
+        std::vector<float> rectcolours;
+
+        //! The values of dcopy from which the vertex positions were last computed
+        std::vector<float> built_z;
     };
 
 } // namespace mplot
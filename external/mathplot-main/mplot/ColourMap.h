@@ -6,6 +6,9 @@
 #include <mplot/colourmaps_cet.h>     // Colour map tables from CET
 
 #include <string_view>
+#include <array>
+#include <vector>
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 #include <cstdint>
@@ -1887,13 +1890,106 @@ namespace mplot {
                 throw std::runtime_error ("Unhandled ColourMap data type.");
             }
 
-            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
-
             // Check for nan and return a 'nan' colour for the colour map
             if constexpr (std::is_same<std::decay_t<T>, double>::value == true
                           || std::is_same<std::decay_t<T>, float>::value == true) {
-                if (std::isnan(datum) == true) { c = ColourMap<T>::nanColour(this->type); return c; }
+                if (std::isnan(datum) == true) { return ColourMap<T>::nanColour(this->type); }
+            }
+
+            return this->convert_unit (datum);
+        }
+
+        /*!
+         * The number of entries in the lookup table that is used by the batch convert(). 4096
+         * entries resolve the datum range [0,1] more finely than any of the tabulated colour
+         * maps, the longest of which have 256 entries.
+         */
+        static constexpr unsigned int lut_size = 4096;
+
+        /*!
+         * Sample this 1D colour map at lut_size evenly spaced datums in [0,1] and store the
+         * result as a lookup table of lut_size RGB triplets. The batch convert() calls bake() as
+         * necessary (whenever the type, hue, saturation or value have changed since the last
+         * bake), so client code need not call it.
+         */
+        void bake()
+        {
+            if (this->numDatums() != 1) { throw std::runtime_error ("ColourMap::bake: Only 1D colour maps can be baked"); }
+            this->lut.resize (3u * ColourMap<T>::lut_size);
+            for (unsigned int i = 0; i < ColourMap<T>::lut_size; ++i) {
+                std::array<float, 3> c = this->convert_unit (static_cast<float>(i) / static_cast<float>(ColourMap<T>::lut_size - 1));
+                this->lut[3u * i] = c[0];
+                this->lut[3u * i + 1] = c[1];
+                this->lut[3u * i + 2] = c[2];
+            }
+            this->lut_params = this->lut_key();
+        }
+
+        //! The baked lookup table; lut_size RGB triplets (empty until bake() has been called)
+        const std::vector<float>& get_lut() const { return this->lut; }
+
+        /*!
+         * Convert every datum in data into an RGB colour, writing the colours into rgb as
+         * consecutive triplets, so that rgb is suitable for a vertex colour buffer.
+         *
+         * For 1D colour maps, the map is baked into a lookup table of lut_size entries (see
+         * bake()) and each datum is converted with an index computation and a three float
+         * copy. This is much faster than calling convert(T) per datum, and the loop is run in
+         * parallel if OpenMP is available. The colours are within 1/(2*(lut_size-1)) in datum
+         * of the result of convert(T). For other colour maps, each datum is passed to convert(T).
+         */
+        void convert (const std::vector<T>& data, std::vector<float>& rgb)
+        {
+            rgb.resize (3u * data.size());
+            const int n = static_cast<int>(data.size());
+
+            if (this->numDatums() != 1) {
+                for (int i = 0; i < n; ++i) {
+                    std::array<float, 3> c = this->convert (data[i]);
+                    std::copy (c.begin(), c.end(), rgb.begin() + 3 * i);
+                }
+                return;
+            }
+
+            if (this->lut.empty() || this->lut_params != this->lut_key()) { this->bake(); }
+
+            const float* lt = this->lut.data();
+            float* out = rgb.data();
+            const std::array<float, 3> nanc = ColourMap<T>::nanColour (this->type);
+            constexpr float lut_max = static_cast<float>(ColourMap<T>::lut_size - 1);
+            [[maybe_unused]] const float rmax = static_cast<float>(this->range_max);
+#pragma omp parallel for
+            for (int i = 0; i < n; ++i) {
+                float datum = 0.0f;
+                if constexpr (std::is_same<std::decay_t<T>, bool>::value == true) {
+                    datum = data[i] ? 1.0f : 0.0f;
+                } else if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                    datum = static_cast<float>(data[i]);
+                    if (std::isnan (datum)) {
+                        out[3 * i] = nanc[0];
+                        out[3 * i + 1] = nanc[1];
+                        out[3 * i + 2] = nanc[2];
+                        continue;
+                    }
+                } else {
+                    datum = static_cast<float>(data[i]) / rmax;
+                }
+                datum = datum > 1.0f ? 1.0f : (datum < 0.0f ? 0.0f : datum);
+                // Table entry 0 is reserved for datum == 0, which some maps treat specially
+                const int li = 3 * (datum > 0.0f ? std::max (1, static_cast<int>(datum * lut_max + 0.5f)) : 0);
+                out[3 * i] = lt[li];
+                out[3 * i + 1] = lt[li + 1];
+                out[3 * i + 2] = lt[li + 2];
             }
+        }
+
+        /*!
+         * Convert datum, which has already been scaled into the range [0,1], into an RGB colour
+         * with this 1D colour map.
+         */
+        std::array<float, 3> convert_unit (const float datum) const
+        {
+            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
 
             switch (this->type) {
             case ColourMapType::Jet:
@@ -3076,6 +3172,16 @@ namespace mplot {
         }
 
     private:
+        //! The lookup table made by bake()
+        std::vector<float> lut;
+        //! The parameters of the 1D colour map at the time of the last bake()
+        std::array<float, 5> lut_params = {};
+        //! The parameters that the 1D colour map (and hence the lookup table) depends on
+        std::array<float, 5> lut_key() const
+        {
+            return { static_cast<float>(this->type), this->hue, this->sat, this->val, this->hue2 };
+        }
+
         /*!
          * @param datum gray value from 0.0 to 1.0
          *
@@ -0,0 +1,172 @@
+/*!
+ * \file
+ *
+ * Declares a GlyphAtlas class to pack many small glyph bitmaps into one single-channel image
+ * which can be used as a single OpenGL texture for a whole font face.
+ *
+ * This class has no GL function calls. VisualFace uploads the atlas pixels to a texture.
+ *
+ * \date Oct 2026
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <sm/vec>
+
+namespace mplot {
+
+    namespace visgl {
+
+        /*!
+         * A shelf-packed glyph atlas. Glyphs are placed left to right on horizontal 'shelves'. A
+         * glyph goes on the lowest shelf that is tall enough (but not very much taller) and has
+         * room for it; if there is none, a new shelf is opened. When the image is full, it is
+         * doubled in size (in height or width, whichever is smaller) and the existing pixels are
+         * copied into the new image, so glyphs keep their pixel positions.
+         */
+        struct GlyphAtlas
+        {
+            //! The largest width or height of the atlas. This is the minimum value of
+            //! GL_MAX_TEXTURE_SIZE required by OpenGL 4.1.
+            static constexpr int max_size = 16384;
+
+            GlyphAtlas (const int _w = 256, const int _h = 256, const int _padding = 1)
+                : w(_w), h(_h), padding(_padding)
+            {
+                this->pix.assign (static_cast<std::size_t>(this->w) * this->h, 0);
+                this->dirty_from = 0;
+                this->dirty_to = this->h;
+            }
+
+            /*!
+             * Add a glyph bitmap of gw by gh pixels whose rows start pitch bytes apart (as in
+             * FreeType's FT_Bitmap). Return the glyph's rectangle in the atlas as {x, y, width,
+             * height}, in pixels, with y measured down from the first row of the image. An empty
+             * glyph (such as a space) takes no room and gets the rectangle {0, 0, 0, 0}.
+             */
+            sm::vec<int, 4> add (const int gw, const int gh, const unsigned char* bitmap, const int pitch)
+            {
+                if (gw <= 0 || gh <= 0) { return { 0, 0, 0, 0 }; }
+                if (gw + 2 * this->padding > max_size || gh + 2 * this->padding > max_size) {
+                    throw std::runtime_error ("GlyphAtlas::add: glyph is larger than the maximum atlas size");
+                }
+
+                sm::vec<int, 2> xy = this->place (gw, gh);
+                while (xy[0] < 0) {
+                    this->grow();
+                    xy = this->place (gw, gh);
+                }
+
+                for (int r = 0; r < gh; ++r) {
+                    std::memcpy (&this->pix[static_cast<std::size_t>(xy[1] + r) * this->w + xy[0]],
+                                 bitmap + static_cast<std::ptrdiff_t>(r) * pitch, gw);
+                }
+                this->dirty_from = std::min (this->dirty_from, xy[1]);
+                this->dirty_to = std::max (this->dirty_to, xy[1] + gh);
+                this->used_area += static_cast<std::size_t>(gw) * gh;
+
+                return { xy[0], xy[1], gw, gh };
+            }
+
+            int width() const { return this->w; }
+            int height() const { return this->h; }
+
+            //! The atlas image, width() by height() bytes, row by row from the top
+            const std::vector<unsigned char>& pixels() const { return this->pix; }
+
+            //! Incremented whenever the atlas changes size. Texture coordinates computed from an
+            //! earlier generation are out of date and a texture must be re-allocated.
+            unsigned int generation() const { return this->gen; }
+
+            //! True if pixels have changed since clear_dirty() was last called
+            bool dirty() const { return this->dirty_to > this->dirty_from; }
+
+            //! The first changed row and one past the last changed row
+            sm::vec<int, 2> dirty_rows() const { return { this->dirty_from, this->dirty_to }; }
+
+            //! Call once the changed rows have been copied to a texture
+            void clear_dirty()
+            {
+                this->dirty_from = this->h;
+                this->dirty_to = 0;
+            }
+
+            //! The proportion of the atlas covered by glyph pixels
+            float occupancy() const
+            {
+                return static_cast<float>(this->used_area) / (static_cast<float>(this->w) * static_cast<float>(this->h));
+            }
+
+        private:
+            //! A row of glyphs
+            struct shelf
+            {
+                int y = 0;      // top of the shelf
+                int height = 0; // height, including padding
+                int x = 0;      // left of the shelf's free space
+            };
+
+            //! Find room for a gw by gh glyph. Return the top left pixel, or {-1, -1} if full.
+            sm::vec<int, 2> place (const int gw, const int gh)
+            {
+                const int pw = gw + this->padding;
+                const int ph = gh + this->padding;
+                // The best shelf is the shortest one that the glyph fits. Glyphs are not put on
+                // shelves much taller than themselves, which would waste the space above them.
+                shelf* best = nullptr;
+                for (auto& s : this->shelves) {
+                    if (s.height < ph || 4 * s.height > 5 * ph + 4) { continue; }
+                    if (s.x + pw > this->w - this->padding) { continue; }
+                    if (best == nullptr || s.height < best->height) { best = &s; }
+                }
+                if (best == nullptr) {
+                    const int y = this->shelves.empty() ? this->padding : this->shelves.back().y + this->shelves.back().height;
+                    if (y + ph > this->h || this->padding + pw > this->w) { return { -1, -1 }; }
+                    this->shelves.push_back (shelf{ y, ph, this->padding });
+                    best = &this->shelves.back();
+                }
+                sm::vec<int, 2> xy = { best->x, best->y };
+                best->x += pw;
+                return xy;
+            }
+
+            //! Double the height or width of the atlas, keeping the pixels where they are
+            void grow()
+            {
+                const int nw = this->w < this->h ? this->w * 2 : this->w;
+                const int nh = this->w < this->h ? this->h : this->h * 2;
+                if (nw > max_size || nh > max_size) {
+                    throw std::runtime_error ("GlyphAtlas::grow: the atlas has reached its maximum size");
+                }
+                std::vector<unsigned char> npix (static_cast<std::size_t>(nw) * nh, 0);
+                for (int r = 0; r < this->h; ++r) {
+                    std::memcpy (&npix[static_cast<std::size_t>(r) * nw], &this->pix[static_cast<std::size_t>(r) * this->w], this->w);
+                }
+                this->pix.swap (npix);
+                this->w = nw;
+                this->h = nh;
+                ++this->gen;
+                // The whole image has to be uploaded into a new texture
+                this->dirty_from = 0;
+                this->dirty_to = this->h;
+            }
+
+            int w = 256;
+            int h = 256;
+            //! Empty pixels around each glyph so that linear texture filtering does not bleed
+            //! neighbouring glyphs into each other
+            int padding = 1;
+            std::vector<unsigned char> pix;
+            std::vector<shelf> shelves;
+            unsigned int gen = 0;
+            int dirty_from = 0;
+            int dirty_to = 0;
+            std::size_t used_area = 0;
+        };
+
+    } // namespace visgl
+} // namespace mplot
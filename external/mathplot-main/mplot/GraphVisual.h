@@ -117,7 +117,14 @@ namespace mplot {
             sm::range<Flt> yrange = this->datarange_y;
             sm::range<Flt> y2range = this->datarange_y2;
             // check x axis
-            if (this->auto_rescale_x) { redraw_plot += xrange.update (_abscissa) ? 1 : 0; }
+            if (this->auto_rescale_x) {
+                const Flt xspan = xrange.span();
+                if (xrange.update (_abscissa)) {
+                    redraw_plot += 1;
+                    // In streaming mode, leave some headroom so that each append doesn't cause a rescale
+                    if (this->stream_window > 0u) { xrange.max += xspan / Flt{2}; }
+                }
+            }
 
             // check y axis
             if (this->auto_rescale_y) {
@@ -128,6 +135,15 @@ namespace mplot {
                 }
             }
 
+            // In streaming mode, slide the window along. If auto-rescaling x, the x axis follows the window.
+            bool trimmed = this->stream_window > 0u ? this->trim_to_window (didx) : false;
+            if (trimmed && this->auto_rescale_x) {
+                const sm::vvec<Flt>& absc = this->datastyles[didx].axisside == mplot::axisside::left ? this->absc1 : this->absc2;
+                xrange = absc.range();
+                xrange.max += xrange.span() / Flt{2};
+                redraw_plot += 1;
+            }
+
             // update graph if necessary
             if (redraw_plot > 0) {
                 this->clear_graph_data();
@@ -154,8 +170,13 @@ namespace mplot {
                 }
             }
 
-            VisualModel<glver>::clear(); // Get rid of the vertices.
-            this->initializeVertices(); // Re-build
+            // In streaming mode, vertices for the new datum are added in render(), unless a full
+            // rebuild is required because the scaling changed or the window moved.
+            if (this->stream_window == 0u || redraw_plot > 0 || trimmed) {
+                VisualModel<glver>::clear(); // Get rid of the vertices.
+                this->initializeVertices(); // Re-build
+                this->full_upload_pending = true;
+            }
         }
 
         //! Before calling the base class's render method, check if we have any pending data
@@ -164,8 +185,17 @@ namespace mplot {
             if (this->pendingAppended == true) {
                 // After adding to graphDataCoords, we have to create the new OpenGL
                 // vertices (CPU side) and update the OpenGL buffers.
+                const std::size_t vstart = this->vertexPositions.size();
+                const std::size_t istart = this->indices.size();
                 this->drawAppendedData();
-                this->reinit_buffers();
+                if (this->stream_window > 0u && this->full_upload_pending == false) {
+                    // Upload only the vertices and marker instances that were just added
+                    this->reinit_buffers_tail (vstart, istart);
+                    if (this->instanced_markers) { this->reinit_instance_buffers_tail(); }
+                } else {
+                    this->reinit_buffers();
+                }
+                this->full_upload_pending = false;
                 this->pendingAppended = false;
             }
             // Now do the usual drawing stuff from VisualModel:
@@ -1008,6 +1038,20 @@ namespace mplot {
             this->resetsize (this->width, this->height);
         }
 
+        /*!
+         * Switch on streaming mode, for graphs that are extended with append() in real time.
+         * Each dataset holds a sliding window of the most recent window data points (at most
+         * 2 * window, as old data is dropped in chunks). If columns is non-zero, lines are also
+         * min/max decimated into that many columns across the graph; pass the on-screen width
+         * of the graph in pixels. The line to the newest point is drawn when the next point is
+         * appended. Call before finalize().
+         */
+        void setstreaming (const std::size_t window, const unsigned int columns = 0u)
+        {
+            this->stream_window = window;
+            this->decimation_columns = columns;
+        }
+
         //! Set the 'object thickness' attribute (maybe used just for 'object spacing')
         void setthickness (float th) { this->relative_thickness = th; }
 
@@ -1027,6 +1071,38 @@ namespace mplot {
         //! Is there pending appended data that needs to be converted into OpenGL shapes?
         bool pendingAppended = false;
 
+        //! Set by append() when it had to rebuild all the vertices, so that render() must upload
+        //! all of them, rather than just the newly appended ones.
+        bool full_upload_pending = false;
+
+        //! The min/max decimated coordinates for each dataset, if decimation_columns > 0
+        std::vector<std::vector<sm::vec<float>>> decimatedCoords;
+
+        /*!
+         * In streaming mode, drop the oldest data for dataset didx once it has grown to twice
+         * stream_window. Dropping data in chunks (rather than one point per append) keeps the
+         * amortised cost of append() independent of the window size. Returns true if data were
+         * dropped, in which case the vertices have to be rebuilt.
+         */
+        bool trim_to_window (const unsigned int didx)
+        {
+            auto trim = [this](auto& v)
+            {
+                if (v.size() < 2u * this->stream_window) { return false; }
+                v.erase (v.begin(), v.end() - this->stream_window);
+                return true;
+            };
+            bool trimmed = trim (*this->graphDataCoords[didx]);
+            if (this->datastyles[didx].axisside == mplot::axisside::left) {
+                trimmed = trim (this->ord1) || trimmed;
+                trim (this->absc1);
+            } else {
+                trimmed = trim (this->ord2) || trimmed;
+                trim (this->absc2);
+            }
+            return trimmed;
+        }
+
         //! Compute stuff for a graph
         void initializeVertices()
         {
@@ -1040,7 +1116,7 @@ namespace mplot {
         }
 
         //! Is the passed in coordinate within the graph axes (in the x/y sense, ignoring z)?
-        bool within_axes (sm::vec<float>& datapoint)
+        bool within_axes (const sm::vec<float>& datapoint)
         {
             bool within = false;
             if (datapoint[0] >= 0 && datapoint[0] <= this->width
@@ -1051,11 +1127,13 @@ namespace mplot {
         }
 
         //! Is the passed in coordinate within the graph axes (in the x sense, ignoring z)?
-        bool within_axes_x (sm::vec<float>& dpt) { return (dpt[0] >= 0 && dpt[0] <= this->width); }
-        bool within_axes_y (sm::vec<float>& dpt) { return (dpt[1] >= 0 && dpt[1] <= this->height); }
+        bool within_axes_x (const sm::vec<float>& dpt) { return (dpt[0] >= 0 && dpt[0] <= this->width); }
+        bool within_axes_y (const sm::vec<float>& dpt) { return (dpt[1] >= 0 && dpt[1] <= this->height); }
 
-        //! dsi: data set iterator
-        void drawDataCommon (unsigned int dsi, unsigned int coords_start, unsigned int coords_end, bool appending = false)
+        //! dsi: data set iterator. coords are the model-space coordinates to draw for this
+        //! dataset; usually *graphDataCoords[dsi], but they may have been decimated.
+        void drawDataCommon (unsigned int dsi, std::vector<sm::vec<float>>& coords,
+                             unsigned int coords_start, unsigned int coords_end, bool appending = false)
         {
             // Draw data markers
             if (this->datastyles[dsi].markerstyle != markerstyle::none) {
@@ -1063,14 +1141,14 @@ namespace mplot {
                 if (this->datastyles[dsi].markerstyle == markerstyle::bar) { // Data markers are bars
 
                     for (unsigned int i = coords_start; i < coords_end; ++i) {
-                        this->bar ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                        this->bar (coords[i], this->datastyles[dsi]);
                     }
 
                 } else if (this->datastyles[dsi].markerstyle == markerstyle::quiver) { // Markers are quivers
 
                     // Check quivers exist and then proceed with code adapted from mplot::QuiverVisual
                     uint64_t nquiv = this->quivers.size();
-                    if ((*this->graphDataCoords[dsi]).size() == nquiv) {
+                    if (coords.size() == nquiv) {
 
                         // Prepare scaling functions
                         if (!this->quiver_colour_scale.ready()) { this->quiver_colour_scale.do_autoscale = true; }
@@ -1115,19 +1193,30 @@ namespace mplot {
                             throw std::runtime_error ("GraphVisual::drawDataCommon: coords_end is off the end of quivers");
                         }
                         for (unsigned int i = coords_start; i < coords_end; ++i) {
-                            this->quiver ((*this->graphDataCoords[dsi])[i], final_quivers[i], colour_qlengths[i], this->datastyles[dsi]);
+                            this->quiver (coords[i], final_quivers[i], colour_qlengths[i], this->datastyles[dsi]);
                         }
 
                     } else {
-                        std::cout << "(*this->graphDataCoords[dsi]).size() = "  << (*this->graphDataCoords[dsi]).size()
+                        std::cout << "coords.size() = "  << coords.size()
                                   << " does not match quivers size: " << quivers.size() << std::endl;
                     }
 
+                } else if (this->instanced_markers) { // One instance of the dataset's marker per point
+
+                    auto& im = this->markerMesh (dsi);
+                    for (unsigned int i = coords_start; i < coords_end; ++i) {
+                        if (this->within_axes (coords[i])) {
+                            sm::vec<float> p = coords[i];
+                            p[2] += this->thickness;
+                            im.add_instance (p, this->datastyles[dsi].markersize * 0.5f, this->datastyles[dsi].markercolour);
+                        }
+                    }
+
                 } else { // Regular data markers
 
                     for (unsigned int i = coords_start; i < coords_end; ++i) {
-                        if (this->within_axes ((*this->graphDataCoords[dsi])[i])) {
-                            this->marker ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                        if (this->within_axes (coords[i])) {
+                            this->marker (coords[i], this->datastyles[dsi]);
                         } // else marker is outside graph axes so don't draw it
                     }
                 }
@@ -1139,24 +1228,45 @@ namespace mplot {
                 // If appending markers to a dataset, need to add the line preceding the first marker
                 if (appending == true) { if (coords_start != 0) { coords_start -= 1; } }
 
-                for (unsigned int i = coords_start+1; i < coords_end; ++i) {
+                // In streaming mode, joined-up lines are drawn only as far as the last-but-one
+                // point. The last line is drawn once the next point has been appended, when its
+                // join is known, so that appended lines are identical to those of a full rebuild.
+                const bool join_appended = this->stream_window > 0u && this->datastyles[dsi].markergap <= 0.0f;
+                unsigned int lines_end = coords_end;
+                if (join_appended) {
+                    if (appending == true && coords_start != 0) { coords_start -= 1; }
+                    lines_end = coords_end > 0u ? coords_end - 1u : 0u;
+                }
+
+                for (unsigned int i = coords_start+1; i < lines_end; ++i) {
                     // Draw tube from location -1 to location 0.
                     if (this->draw_beyond_axes == true
-                        || (this->within_axes ((*this->graphDataCoords[dsi])[i-1])
-                            && this->within_axes ((*this->graphDataCoords[dsi])[i]))) {
+                        || (this->within_axes (coords[i-1])
+                            && this->within_axes (coords[i]))) {
 
                         if (this->datastyles[dsi].markergap > 0.0f) {
-                            auto point_to_point = (*this->graphDataCoords[dsi])[i] - (*this->graphDataCoords[dsi])[i-1];
+                            auto point_to_point = coords[i] - coords[i-1];
                             if (point_to_point.length() > this->datastyles[dsi].markergap * 2.0f) {
                                 // Draw solid lines between marker points with gaps between line and marker
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i], sm::vec<>::uz(),
+                                this->computeFlatLine (coords[i-1], coords[i], sm::vec<>::uz(),
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth, this->datastyles[dsi].markergap);
                             }
+                        } else if (join_appended) {
+                            // The previous and next points are both known (except before the first)
+                            if (i == 1u) {
+                                this->computeFlatLineN (coords[i-1], coords[i], coords[i+1], sm::vec<>::uz(),
+                                                        this->datastyles[dsi].linecolour,
+                                                        this->datastyles[dsi].linewidth);
+                            } else {
+                                this->computeFlatLine (coords[i-1], coords[i], coords[i-2], coords[i+1], sm::vec<>::uz(),
+                                                       this->datastyles[dsi].linecolour,
+                                                       this->datastyles[dsi].linewidth);
+                            }
                         } else if (appending == true) {
                             // We are appending a line to an existing graph, so compute a single line with rounded ends
-                            this->computeFlatLineRnd ((*this->graphDataCoords[dsi])[i-1], // start
-                                                      (*this->graphDataCoords[dsi])[i],   // end
+                            this->computeFlatLineRnd (coords[i-1], // start
+                                                      coords[i],   // end
                                                       sm::vec<>::uz(),
                                                       this->datastyles[dsi].linecolour,
                                                       this->datastyles[dsi].linewidth, 0.0f, true, false);
@@ -1168,30 +1278,30 @@ namespace mplot {
                             // and draw the alt colour (which may be bg colour) between the dashes.
                             if (i == 1+coords_start && (coords_end-coords_start)==2) {
                                 // First and only line
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], // start
-                                                       (*this->graphDataCoords[dsi])[i],   // end
+                                this->computeFlatLine (coords[i-1], // start
+                                                       coords[i],   // end
                                                        sm::vec<>::uz(),
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth);
                             } else if (i == 1+coords_start) {
                                 // First line
-                                this->computeFlatLineN ((*this->graphDataCoords[dsi])[i-1], // start
-                                                        (*this->graphDataCoords[dsi])[i],   // end
-                                                        (*this->graphDataCoords[dsi])[i+1], // next
+                                this->computeFlatLineN (coords[i-1], // start
+                                                        coords[i],   // end
+                                                        coords[i+1], // next
                                                         sm::vec<>::uz(),
                                                         this->datastyles[dsi].linecolour,
                                                         this->datastyles[dsi].linewidth);
                             } else if (i == (coords_end-1)) {
                                 // last line
-                                this->computeFlatLineP ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i],
-                                                        (*this->graphDataCoords[dsi])[i-2],
+                                this->computeFlatLineP (coords[i-1], coords[i],
+                                                        coords[i-2],
                                                         sm::vec<>::uz(),
                                                         this->datastyles[dsi].linecolour,
                                                         this->datastyles[dsi].linewidth);
                             } else {
                                 // An intermediate line
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i],
-                                                       (*this->graphDataCoords[dsi])[i-2], (*this->graphDataCoords[dsi])[i+1],
+                                this->computeFlatLine (coords[i-1], coords[i],
+                                                       coords[i-2], coords[i+1],
                                                        sm::vec<>::uz(),
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth);
@@ -1206,15 +1316,35 @@ namespace mplot {
         // Defines a boolean 'true' that can be provided as arg to drawDataCommon()
         static constexpr bool appending_data = true;
 
+        //! Should the lines of dataset dsi be min/max decimated? Bars and quivers never are.
+        bool decimating (unsigned int dsi) const
+        {
+            return this->decimation_columns > 0u
+            && this->datastyles[dsi].markerstyle != markerstyle::bar
+            && this->datastyles[dsi].markerstyle != markerstyle::quiver;
+        }
+
         //! Draw markers and lines for data points that are being appended to a graph
         void drawAppendedData()
         {
+            this->decimatedCoords.resize (this->graphDataCoords.size());
             for (unsigned int dsi = 0; dsi < this->graphDataCoords.size(); ++dsi) {
                 // Start is old end:
                 unsigned int coords_start = this->coords_lengths[dsi];
                 unsigned int coords_end = static_cast<unsigned int>(this->graphDataCoords[dsi]->size());
-                this->coords_lengths[dsi] = coords_end;
-                this->drawDataCommon (dsi, coords_start, coords_end, appending_data);
+                if (this->decimating (dsi)) {
+                    // Decimate only the completed pixel columns. The column that is still
+                    // filling up will be drawn once data arrives in the next column.
+                    unsigned int dec_start = static_cast<unsigned int>(this->decimatedCoords[dsi].size());
+                    this->coords_lengths[dsi] = mplot::graphing::decimate_minmax (*this->graphDataCoords[dsi], coords_start, coords_end,
+                                                                                  this->width, this->decimation_columns, false,
+                                                                                  this->decimatedCoords[dsi]);
+                    unsigned int dec_end = static_cast<unsigned int>(this->decimatedCoords[dsi].size());
+                    this->drawDataCommon (dsi, this->decimatedCoords[dsi], dec_start, dec_end, appending_data);
+                } else {
+                    this->coords_lengths[dsi] = coords_end;
+                    this->drawDataCommon (dsi, *this->graphDataCoords[dsi], coords_start, coords_end, appending_data);
+                }
             }
         }
 
@@ -1223,11 +1353,23 @@ namespace mplot {
         {
             unsigned int coords_start = 0;
             this->coords_lengths.resize (this->graphDataCoords.size());
+            this->decimatedCoords.resize (this->graphDataCoords.size());
             for (unsigned int dsi = 0; dsi < static_cast<unsigned int>(this->graphDataCoords.size()); ++dsi) {
                 unsigned int coords_end = this->graphDataCoords[dsi]->size();
-                // Record coords length for future appending:
-                this->coords_lengths[dsi] = coords_end;
-                this->drawDataCommon (dsi, coords_start, coords_end);
+                if (this->decimating (dsi)) {
+                    // In streaming mode, the last column is left for drawAppendedData() to complete
+                    const bool flush = this->stream_window == 0u;
+                    this->decimatedCoords[dsi].clear();
+                    this->coords_lengths[dsi] = mplot::graphing::decimate_minmax (*this->graphDataCoords[dsi], coords_start, coords_end,
+                                                                                  this->width, this->decimation_columns, flush,
+                                                                                  this->decimatedCoords[dsi]);
+                    this->drawDataCommon (dsi, this->decimatedCoords[dsi], 0u,
+                                          static_cast<unsigned int>(this->decimatedCoords[dsi].size()));
+                } else {
+                    // Record coords length for future appending:
+                    this->coords_lengths[dsi] = coords_end;
+                    this->drawDataCommon (dsi, *this->graphDataCoords[dsi], coords_start, coords_end);
+                }
             }
         }
 
@@ -1802,6 +1944,20 @@ namespace mplot {
             }
         }
 
+        //! The instanced mesh for the markers of dataset dsi: a marker of radius 1 at the origin
+        typename VisualModel<glver>::instanced_mesh& markerMesh (const unsigned int dsi)
+        {
+            auto& im = this->instmesh (dsi);
+            if (im.indices.empty()) {
+                mplot::DatasetStyle unit_style = this->datastyles[dsi];
+                unit_style.markersize = 2.0f;
+                // marker() raises markers above the graph by thickness; the instances are raised instead
+                sm::vec<float> origin = { 0.0f, 0.0f, -this->thickness };
+                this->computeInstancedMesh (im, [this, &origin, &unit_style]() { this->marker (origin, unit_style); });
+            }
+            return im;
+        }
+
         // Create an n sided polygon with first vertex 'pointing up'
         void polygonMarker (sm::vec<float> p, int n, const mplot::DatasetStyle& style)
         {
@@ -1949,6 +2105,16 @@ namespace mplot {
         bool auto_rescale_y = false;
         //! in the update function, it fits the scale with the range of the data (/!\ will scope only on the last datasets per y axis)
         bool auto_rescale_fit = false;
+        //! Streaming mode. If non-zero, each dataset extended with append() keeps a sliding
+        //! window of this many recent points and only newly appended vertices are uploaded.
+        std::size_t stream_window = 0u;
+        //! If non-zero, lines are min/max decimated into this many columns across the graph
+        //! width. Set it to the graph's on-screen width in pixels.
+        unsigned int decimation_columns = 0u;
+        //! If true, the data markers of each dataset are drawn as instances of a single marker
+        //! mesh, which is much lighter for datasets with many points. Legend markers, bars and
+        //! quivers are drawn as before.
+        bool instanced_markers = false;
         //! Current DatasetStyle for ord1
         mplot::DatasetStyle ds_ord1;
         //! DatasetStyle for ord2
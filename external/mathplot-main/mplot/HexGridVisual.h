@@ -3,6 +3,9 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <set>
+#include <algorithm>
+#include <cmath>
 #include <sm/vec>
 #include <sm/vvec>
 #include <sm/hexgrid>
@@ -123,31 +126,66 @@ namespace mplot {
             }
         }
 
-        // This locally defined reinit function knows that we don't want to clear vertexPositions/vertexNormals
+        /*!
+         * Update the model after the data has changed, re-computing and uploading only the
+         * vertex buffers that depend on the data. The hexgrid, and hence the indices, are
+         * assumed not to have changed. The colours are always updated. In Triangles mode, the
+         * z positions are updated if they have changed. In HexInterp mode, positions and normals
+         * are re-computed only if the z values have changed (so a flat HexGridVisual with a zero
+         * zScale is updated by uploading its colour buffer only). A full reinit() is made if the
+         * model has not been built yet, or if it shows anything other than the hexes.
+         */
         void reinit_on_update()
         {
+            const std::size_t nhex = this->hg->num();
+            const std::size_t verts_per_hex = this->hexVisMode == HexVisMode::Triangles ? 1u : 7u;
+            this->determine_datasize();
+            if (this->datasize != nhex || this->vertexColors.size() != 3u * verts_per_hex * nhex
+                || (this->hexVisMode != HexVisMode::Triangles && (!this->showhexes || this->showoverlap || this->zerogrid))) {
+                VisualDataModel<T,glver>::reinit();
+                return;
+            }
+
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
-            // No need to set idx to 0 on an update, or clear/empty vertex/indices containers
-            this->initializeVertices (true); // true for 'update' not 'initial build'
-            this->reinit_buffers(); // could potentially be 'reinit_position_color_buffers_only()'
+            this->setupScaling();
+
+            if (this->hexVisMode == HexVisMode::Triangles) {
+                bool z_changed = false;
+                for (std::size_t hi = 0; hi < nhex; ++hi) {
+                    const float z = this->dataCoords == nullptr ? this->zoom * this->dcopy[hi] : (*this->dataCoords)[hi][2];
+                    z_changed = z_changed || this->vertexPositions[3u * hi + 2] != z;
+                    this->vertexPositions[3u * hi + 2] = z;
+                }
+                this->computeColours (this->vertexColors);
+                for (auto hi : this->markedHexes) {
+                    if (hi < nhex) { std::fill_n (this->vertexColors.begin() + 3u * hi, 3, 0.0f); }
+                }
+                if (z_changed) { this->reinit_position_buffer(); }
+
+            } else if (this->dataCoords == nullptr
+                       && static_cast<const std::vector<float>&>(this->dcopy) == this->built_z) {
+                this->computeColours (this->hexcolours);
+                this->fillHexColours();
+
+            } else {
+                this->vertexPositions.clear();
+                this->vertexNormals.clear();
+                this->vertexColors.clear();
+                this->indices.clear();
+                this->idx = 0;
+                this->computeHexes();
+                this->reinit_position_buffer();
+                this->reinit_normal_buffer();
+            }
+
+            this->reinit_colour_buffer();
         }
 
-        // Override the updateData method
+        //! Update the scalar data, re-uploading only the vertex buffers that change (see reinit_on_update)
         void updateData (const std::vector<T>* _data)
         {
             this->scalarData = _data;
-            switch (this->hexVisMode) {
-            case HexVisMode::Triangles:
-            {
-                this->reinit_on_update(); // instead of VisualDataModel<T,glver>::reinit().
-                break;
-            }
-            default:
-            {
-                VisualDataModel<T,glver>::reinit();
-                break;
-            }
-            }
+            this->reinit_on_update();
         }
 
         // Initialize vertex buffer objects and vertex array object.
@@ -166,6 +204,7 @@ namespace mplot {
             this->setupScaling();
 
             std::array<float, 3> blkclr = {0,0,0};
+            this->computeColours (this->hexcolours);
 
             if (update == false) {
                 this->vertexPositions.resize (3u * nhex);
@@ -175,7 +214,7 @@ namespace mplot {
             }
 
             for (unsigned int hi = 0; hi < nhex; ++hi) {
-                std::array<float, 3> clr = this->setColour (hi);
+                const float* clr = this->hexcolours.data() + 3u * hi;
                 // If dataCoords has been populated, use these for hex positions, allowing for
                 // mapping of the 2D hexgrid onto a 3D manifold.
                 if (this->dataCoords == nullptr) {
@@ -266,6 +305,8 @@ namespace mplot {
             unsigned int nhex = this->hg->num();
 
             this->setupScaling();
+            this->computeColours (this->hexcolours);
+            this->built_z = this->dcopy;
 
             // x and y coords on the hexgrid. May be replaced if dataCoords has been set.
             float _x = 0.0f;
@@ -329,7 +370,7 @@ namespace mplot {
 
                 // Use a single colour for each hex, even though hex z positions are
                 // interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (hi);
+                std::array<float, 3> clr = { this->hexcolours[3u * hi], this->hexcolours[3u * hi + 1], this->hexcolours[3u * hi + 2] };
                 if (this->showboundary && (this->hg->vhexen[hi])->boundaryHex() == true) {
                     this->markHex (hi);
                 }
@@ -604,6 +645,32 @@ namespace mplot {
             }
         }
 
+        /*!
+         * Write hexcolours into the seven vertices of each hex in vertexColors, with the same
+         * pattern of black vertices for NaN and for marked hexes as computeHexes().
+         */
+        void fillHexColours()
+        {
+            const int nhex = static_cast<int>(this->hg->num());
+            float* vc = this->vertexColors.data();
+            const float* hc = this->hexcolours.data();
+#pragma omp parallel for
+            for (int hi = 0; hi < nhex; ++hi) {
+                const bool nan_hex = std::isnan (this->dcolour[hi]);
+                for (int v = 0; v < 7; ++v) {
+                    const bool blk = nan_hex && v > 0;
+                    vc[21 * hi + 3 * v] = blk ? 0.0f : hc[3 * hi];
+                    vc[21 * hi + 3 * v + 1] = blk ? 0.0f : hc[3 * hi + 1];
+                    vc[21 * hi + 3 * v + 2] = blk ? 0.0f : hc[3 * hi + 2];
+                }
+            }
+            // Vertices 1, 3 and 5 of a marked hex are black
+            for (auto hi : this->markedHexes) {
+                if (hi >= this->hg->num()) { continue; }
+                for (unsigned int v = 1; v < 7; v += 2) { std::fill_n (this->vertexColors.begin() + 21u * hi + 3u * v, 3, 0.0f); }
+            }
+        }
+
         // Show a Flat surface for the zero plane. Currently, this is expensively
         // plotting out all the hexes because that was easy. it could be simply a big
         // rectangle of two triangles.
@@ -1072,6 +1139,12 @@ namespace mplot {
         //! The hexgrid to visualize. This is not expected to change (update methods may
         //! assume the hexgrid has remained unaltered)
         const sm::hexgrid* hg;
+
+        //! The colour of each hex, computed by a batch ColourMap conversion of dcolour
+        std::vector<float> hexcolours;
+
+        //! The values of dcopy from which the hex vertex positions were last computed
+        std::vector<float> built_z;
     };
 
 } // namespace mplot
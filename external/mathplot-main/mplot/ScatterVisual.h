@@ -48,38 +48,94 @@ namespace mplot {
             }
         }
 
+        /*!
+         * The instanced mesh for the markers: a marker of radius 1 centred on the origin. Rods are
+         * not scaled along markerdirn.
+         */
+        typename VisualDataModel<Flt, glver>::instanced_mesh& markerMesh()
+        {
+            auto& im = this->instmesh (0);
+            if (im.indices.empty()) {
+                constexpr std::array<float, 3> clr = { 0.0f, 0.0f, 0.0f }; // instances have their own colours
+                this->computeInstancedMesh (im, [this, &clr]() { this->marker (sm::vec<float>{}, clr, Flt{1}); });
+                if (this->markers == mplot::markerstyle::rod) {
+                    im.axis = this->markerdirn;
+                    im.axis.renormalize();
+                }
+            }
+            return im;
+        }
+
         //! Quick hack to add an additional point
         void add (sm::vec<float> coord, Flt value)
         {
-            std::array<float, 3> clr = this->cm.convert (this->colourScale.transform_one (value));
-            this->marker (coord, clr, this->radiusFixed);
-            this->reinit_buffers();
+            this->add (coord, value, this->radiusFixed);
         }
 
         //! Additional point with variable size
         void add (sm::vec<float> coord, Flt value, Flt size)
         {
             std::array<float, 3> clr = this->cm.convert (this->colourScale.transform_one (value));
-            this->marker (coord, clr, size);
-            this->reinit_buffers();
+            if (this->instanced_markers) {
+                this->markerMesh().add_instance (coord, static_cast<float>(size), clr);
+                this->reinit_instance_buffers_tail();
+            } else {
+                this->marker (coord, clr, size);
+                this->reinit_buffers();
+            }
+        }
+
+        /*!
+         * With instanced_markers, recompute the marker positions, sizes and colours from the data
+         * and upload only those, without recomputing any vertices or labels. Call this after
+         * changing the data that dataCoords, scalarData or vectorData point to.
+         */
+        void reinit_instances()
+        {
+            if (!this->instanced_markers) { this->reinit(); return; }
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            this->markerMesh().clear_instances();
+            this->computeMarkers();
+            this->update_bb();
+            if (this->flags.test (vm_bools::compute_bb)) {
+                this->reinit_buffers(); // to upload the new bounding box
+            } else {
+                this->reinit_instance_buffers();
+            }
         }
 
         //! Compute spheres for a scatter plot
         void initializeVertices()
+        {
+            if (this->computeMarkers() == false) { return; }
+
+            if (this->labelIndices == true) {
+                for (unsigned int i = 0; i < this->dataCoords->size(); ++i) {
+                    // Draw an index label...
+                    this->addLabel (std::to_string (i), (*this->dataCoords)[i] + labelOffset, mplot::TextFeatures(labelSize) );
+                }
+            }
+        }
+
+        /*!
+         * Compute a marker (or, with instanced_markers, a marker instance) for each data
+         * point. Return false if the data are missing or inconsistent.
+         */
+        bool computeMarkers()
         {
             unsigned int ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
-            if (ncoords == 0) { return; }
+            if (ncoords == 0) { return false; }
             unsigned int ndata = this->scalarData == nullptr ? 0 : this->scalarData->size();
             // If we have vector data, then manipulate colour accordingly.
             unsigned int nvdata = this->vectorData == nullptr ? 0 : this->vectorData->size();
 
             if (ndata > 0 && ncoords != ndata) {
                 std::cout << "ScatterVisual Error: ncoords ("<<ncoords<<") != ndata ("<<ndata<<"), return (no model)." << std::endl;
-                return;
+                return false;
             }
             if (nvdata > 0 && ncoords != nvdata) {
                 std::cout << "ScatterVisual Error: ncoords ("<<ncoords<<") != nvdata ("<<nvdata<<"), return (no model)." << std::endl;
-                return;
+                return false;
             }
 
             // Find the minimum distance between points to get a radius? Or just allow
@@ -131,17 +187,14 @@ namespace mplot {
                     clr = this->cm.convert (vdcopy1[i], vdcopy2[i]);
                 }
 
-                if (this->sizeFactor == Flt{0}) {
-                    this->marker ((*this->dataCoords)[i], clr, this->radiusFixed);
+                Flt size = this->sizeFactor == Flt{0} ? this->radiusFixed : dcopy[i] * this->sizeFactor;
+                if (this->instanced_markers) {
+                    this->markerMesh().add_instance ((*this->dataCoords)[i], static_cast<float>(size), clr);
                 } else {
-                    this->marker ((*this->dataCoords)[i], clr, dcopy[i] * this->sizeFactor);
-                }
-
-                if (this->labelIndices == true) {
-                    // Draw an index label...
-                    this->addLabel (std::to_string (i), (*this->dataCoords)[i] + labelOffset, mplot::TextFeatures(labelSize) );
+                    this->marker ((*this->dataCoords)[i], clr, size);
                 }
             }
+            return true;
         }
 
         // The constexpr, unordered geodesic code is no slower than the regular
@@ -162,6 +215,14 @@ namespace mplot {
         // Marker direction, if relevant. Used for length of rod markers
         sm::vec<float, 3> markerdirn = sm::vec<>::uz();
 
+        /*!
+         * If true, draw the markers as instances of one shared marker mesh. Each marker then
+         * needs 7 floats rather than a whole sphere or rod of vertices, and reinit_instances()
+         * can update positions, sizes and colours without recomputing any vertices. Requires the
+         * default shaders.
+         */
+        bool instanced_markers = false;
+
         //! Change this to get larger or smaller spheres.
         Flt radiusFixed = Flt{0.05};
         Flt sizeFactor = Flt{0};
@@ -11,11 +11,15 @@
 
 #include <string>
 #include <array>
+#include <algorithm>
+#include <iostream>
 #include <vector>
 #include <map>
 #include <tuple>
 #include <memory>
 #include <functional>
+#include <future>
+#include <chrono>
 #include <cstddef>
 
 #include <sm/flags>
@@ -28,6 +32,7 @@
 #include <mplot/TextFeatures.h>
 #include <mplot/TextGeometry.h>
 #include <mplot/VisualCommon.h>
+#include <mplot/WorkerPool.h>
 #include <mplot/gl/shaders.h>
 #include <mplot/keys.h>
 #include <mplot/version.h>
@@ -193,10 +198,17 @@ namespace mplot {
         virtual void setSwapInterval() {}  // no op here
         virtual void swapBuffers() {}      // no op here
 
-        // A callback friendly wrapper for setContext
-        static void set_context (mplot::VisualBase<glver>* _v) { _v->setContext(); };
+        // A callback friendly wrapper for setContext. Models that are being built on a worker
+        // thread (see addVisualModelAsync) must not take the context, so this is then a no-op.
+        static void set_context (mplot::VisualBase<glver>* _v)
+        {
+            if (!mplot::visgl::model_build_thread) { _v->setContext(); }
+        };
         // A callback friendly wrapper for releaseContext
-        static void release_context (mplot::VisualBase<glver>* _v) { _v->releaseContext(); };
+        static void release_context (mplot::VisualBase<glver>* _v)
+        {
+            if (!mplot::visgl::model_build_thread) { _v->releaseContext(); }
+        };
 
         // Public init that is given a context (window or widget) and then sets up the
         // VisualResource, shaders and so on.
@@ -296,6 +308,84 @@ namespace mplot {
             if (found_model == true) { this->vm.erase (this->vm.begin() + modelId); }
         }
 
+        /*!
+         * Add a VisualModel to the scene, building its vertices on a worker thread. This is the
+         * asynchronous version of the usual pattern:
+         *
+         * \code
+         *   auto hgv = std::make_unique<mplot::HexGridVisual<float>>(&hg, offset);
+         *   v.bindmodel (hgv);
+         *   hgv->setScalarData (&data);
+         *   hgv->finalize();                  // Computes vertices on this thread
+         *   v.addVisualModel (hgv);
+         * \endcode
+         *
+         * becomes
+         *
+         * \code
+         *   auto hgv = std::make_unique<mplot::HexGridVisual<float>>(&hg, offset);
+         *   v.bindmodel (hgv);
+         *   hgv->setScalarData (&data);
+         *   auto hgvp = v.addVisualModelAsync (hgv); // finalize() runs on a worker thread
+         * \endcode
+         *
+         * Ownership rules:
+         *
+         * - The model belongs to the worker until it has been built and adopted into the scene,
+         *   which happens in the next render() after it is built (or in waitForModels()). Until
+         *   then, the returned pointer must not be used and the model does not appear in the
+         *   scene. Adopted models appear in the order in which they were submitted.
+         *
+         * - Workers make no GL calls. On a worker, the model's setContext/releaseContext
+         *   callbacks are no-ops and its GL buffers are created on the render thread when the
+         *   model is first rendered.
+         *
+         * - Call the *Async functions, waitForModels() and setBuildThreads() from the thread that
+         *   renders this Visual. If another thread renders, hold the Visual's context lock
+         *   (lockContext()/unlockContext()) during the call, as in the twowindows example.
+         *
+         * - Any data that the model points to (such as the Grid and the data passed to
+         *   setScalarData) must stay unchanged until the model has been adopted.
+         */
+        template <typename T>
+        T* addVisualModelAsync (std::unique_ptr<T>& model)
+        {
+            return this->submitModel (model, nullptr);
+        }
+
+        /*!
+         * Build model on a worker thread, then swap it into the scene in place of old (a model
+         * that is already in the scene). old is drawn until model is ready, so that a scene can
+         * be refreshed with new geometry without a frame in which the model is missing. If old has
+         * been removed by the time model is ready, model is added at the end of the scene. The
+         * ownership rules of addVisualModelAsync apply.
+         */
+        template <typename T>
+        T* replaceVisualModelAsync (const mplot::VisualModel<glver>* old, std::unique_ptr<T>& model)
+        {
+            return this->submitModel (model, old);
+        }
+
+        //! The number of models submitted with addVisualModelAsync/replaceVisualModelAsync that
+        //! have not yet been adopted into the scene
+        std::size_t modelsBuilding() const { return this->pending.size(); }
+
+        //! Block until all the models being built are ready, then adopt them into the scene
+        void waitForModels()
+        {
+            for (auto& p : this->pending) { p.built.wait(); }
+            this->adoptBuiltModels();
+        }
+
+        //! Set the number of threads used to build models (the default, 0, means one per hardware
+        //! thread). Waits for any models already being built.
+        void setBuildThreads (unsigned int n)
+        {
+            this->waitForModels();
+            this->builders.reset (nullptr);
+            this->build_threads = n;
+        }
+
         void set_cursorpos (double _x, double _y) { this->cursorpos = {static_cast<float>(_x), static_cast<float>(_y)}; }
 
         //! A callback function
@@ -798,6 +888,75 @@ namespace mplot {
         //! ScatterVisual, etc) which are going to be rendered in the scene.
         std::vector<std::unique_ptr<mplot::VisualModel<glver>>> vm;
 
+        //! A model that is being built by a worker thread
+        struct pending_model
+        {
+            std::unique_ptr<mplot::VisualModel<glver>> model;
+            //! Ready when the model's vertices have been built
+            std::future<void> built;
+            //! The model in vm that this one will replace, if any
+            const mplot::VisualModel<glver>* replaces = nullptr;
+        };
+        //! Models being built, in the order they were submitted
+        std::vector<pending_model> pending;
+        //! The threads that build models. Created when the first model is submitted.
+        std::unique_ptr<mplot::visgl::worker_pool> builders;
+        //! How many threads builders should have (0 for one per hardware thread)
+        unsigned int build_threads = 0;
+
+        template <typename T>
+        T* submitModel (std::unique_ptr<T>& model, const mplot::VisualModel<glver>* old)
+        {
+            if (!this->builders) { this->builders = std::make_unique<mplot::visgl::worker_pool> (this->build_threads); }
+            T* rtn = model.get();
+            pending_model p;
+            p.model = std::move (model);
+            p.replaces = old;
+            p.built = this->builders->submit ([rtn]() { rtn->finalize(); });
+            this->pending.push_back (std::move (p));
+            return rtn;
+        }
+
+        /*!
+         * Move the models that have been built into vm. Models are adopted in the order in which
+         * they were submitted, so this stops at the first model that is still being built. Called
+         * at the start of render(), with the context held, because a replaced model frees its GL
+         * buffers.
+         */
+        void adoptBuiltModels()
+        {
+            std::size_t n = 0;
+            for (; n < this->pending.size(); ++n) {
+                pending_model& p = this->pending[n];
+                if (p.built.wait_for (std::chrono::seconds(0)) != std::future_status::ready) { break; }
+                try {
+                    p.built.get();
+                } catch (const std::exception& e) {
+                    std::cerr << "ERROR building VisualModel on a worker thread: " << e.what() << std::endl;
+                    continue; // The model is discarded
+                }
+                auto slot = this->vm.end();
+                if (p.replaces != nullptr) {
+                    slot = std::find_if (this->vm.begin(), this->vm.end(),
+                                         [&p](const auto& m) { return m.get() == p.replaces; });
+                }
+                if (slot != this->vm.end()) {
+                    *slot = std::move (p.model);
+                } else {
+                    this->vm.push_back (std::move (p.model));
+                }
+            }
+            this->pending.erase (this->pending.begin(), this->pending.begin() + n);
+        }
+
+        //! Stop the model-building threads, discarding models that have not been adopted. Called
+        //! on deconstruction.
+        void stopBuilders()
+        {
+            this->builders.reset (nullptr); // Joins the threads once queued builds have run
+            this->pending.clear();
+        }
+
         // Initialize OpenGL shaders, set some flags (Alpha, Anti-aliasing), read in any external
         // state from json, and set up the coordinate arrows and any VisualTextModels that will be
         // required to render the Visual.
@@ -38,13 +38,22 @@ namespace mplot {
         };
 
         //! The locations for the position, normal and colour vertex attributes in the
-        //! mplot::Visual GLSL programs
-        enum AttribLocn { posnLoc = 0, normLoc = 1, colLoc = 2, textureLoc = 3 };
+        //! mplot::Visual GLSL programs. instPosnLoc is the per-instance position and scale of an
+        //! instanced mesh (see VisualModelBase::instanced_mesh)
+        enum AttribLocn { posnLoc = 0, normLoc = 1, colLoc = 2, textureLoc = 3, instPosnLoc = 4 };
+
+        /*!
+         * True on a thread that is building VisualModel vertices away from the render thread (see
+         * VisualBase::addVisualModelAsync). Such a thread must make no OpenGL calls. The context
+         * callbacks do nothing on it and the GL set-up of any models and texts that it builds is
+         * left for the render thread to do in render().
+         */
+        inline thread_local bool model_build_thread = false;
 
         //! A struct to hold information about font glyph properties
         struct CharInfo
         {
-            //! ID handle of the glyph texture
+            //! ID handle of the glyph texture (the atlas texture of the glyph's face, once created)
             unsigned int textureID;
             //! Size of glyph
             sm::vec<int,2>  size;
@@ -52,6 +61,8 @@ namespace mplot {
             sm::vec<int,2>  bearing;
             //! Offset to advance to next glyph
             unsigned int advance;
+            //! The glyph's pixels in the face's atlas: x, y, width, height
+            sm::vec<int,4> atlas_rect = {};
         };
 
     } // namespace gl
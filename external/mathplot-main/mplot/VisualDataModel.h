@@ -161,6 +161,24 @@ namespace mplot
             return clr;
         }
 
+        /*!
+         * Compute the colour of every element into rgb (as consecutive RGB triplets). For 1D
+         * colour maps this uses the ColourMap's lookup table batch conversion; otherwise it
+         * calls setColour() for each element.
+         */
+        void computeColours (std::vector<float>& rgb)
+        {
+            if (this->cm.numDatums() == 1) {
+                this->cm.convert (this->dcolour, rgb);
+            } else {
+                rgb.resize (3u * this->dcolour.size());
+                for (uint64_t ri = 0; ri < this->dcolour.size(); ++ri) {
+                    std::array<float, 3> clr = this->setColour (ri);
+                    std::copy (clr.begin(), clr.end(), rgb.begin() + 3u * ri);
+                }
+            }
+        }
+
         //! Find datasize
         void determine_datasize()
         {
@@ -103,9 +103,12 @@ namespace mplot {
     "uniform mat4 v_matrix;\n"
     "uniform mat4 p_matrix;\n"
     "uniform float alpha;\n"
+    "uniform int instanced;\n"
+    "uniform vec3 instance_axis;\n"
     "layout(location = 0) in vec4 position;\n"
     "layout(location = 1) in vec4 normalin;\n"
     "layout(location = 2) in vec3 color;\n"
+    "layout(location = 4) in vec4 instance_posn;\n"
     "out VERTEX\n"
     "{\n"
     "    vec4 normal;\n"
@@ -114,9 +117,14 @@ namespace mplot {
     "} vertex;\n"
     "void main()\n"
     "{\n"
-    "    gl_Position = (p_matrix * v_matrix * m_matrix * position);\n"
+    "    vec4 p = position;\n"
+    "    if (instanced == 1) {\n"
+    "        vec3 axial = dot(position.xyz, instance_axis) * instance_axis;\n"
+    "        p = vec4(axial + (position.xyz - axial) * instance_posn.w + instance_posn.xyz, 1.0);\n"
+    "    }\n"
+    "    gl_Position = (p_matrix * v_matrix * m_matrix * p);\n"
     "    vertex.color = vec4(color, alpha);\n"
-    "    vertex.fragpos = vec3(m_matrix * position);\n"
+    "    vertex.fragpos = vec3(m_matrix * p);\n"
     "    vertex.normal = normalin;\n"
     "}\n";
 
@@ -168,10 +176,12 @@ namespace mplot {
     "layout(location = 2) in vec4 vcolor;\n"
     "layout(location = 3) in vec4 texture;\n"
     "out vec2 TexCoords;\n"
+    "out vec3 VColor;\n"
     "void main()\n"
     "{\n"
     "    gl_Position = p_matrix * v_matrix * m_matrix * position;\n"
     "    TexCoords = texture.xy;\n"
+    "    VColor = vcolor.rgb;\n"
     "}";
 
     std::string getDefaultTextVtxShader (const int glver)
@@ -184,12 +194,15 @@ namespace mplot {
 
     // Default text fragment shader. See VisText.frag.glsl
     const char* defaultTextFragShader = "in vec2 TexCoords;\n"
+    "in vec3 VColor;\n"
     "out vec4 color;\n"
     "uniform sampler2D text;\n"
     "uniform vec3 textColor;\n"
+    "uniform int vertexcolour;\n"
     "void main()\n"
     "{\n"
-    "    color = vec4(textColor, texture(text, TexCoords).r);\n"
+    "    vec3 c = vertexcolour == 1 ? VColor : textColor;\n"
+    "    color = vec4(c, texture(text, TexCoords).r);\n"
     "}\n";
 
     std::string getDefaultTextFragShader (const int glver)
@@ -210,7 +223,10 @@ namespace mplot {
     "uniform vec4 cyl_cam_pos = vec4(0);\n"
     "layout(location = 0) in vec4 position;\n"
     "layout(location = 1) in vec4 normalin;\n"
+    "uniform int instanced;\n"
+    "uniform vec3 instance_axis;\n"
     "layout(location = 2) in vec3 color;\n"
+    "layout(location = 4) in vec4 instance_posn;\n"
     "out VERTEX\n"
     "{\n"
     "    vec4 normal;\n"
@@ -222,7 +238,12 @@ namespace mplot {
     "    const float pi = 3.1415927;\n"
     "    const float two_pi = 6.283185307;\n"
     "    const float heading_offset = 1.570796327;\n"
-    "    vec4 pv = (v_matrix * m_matrix * position);\n"
+    "    vec4 p = position;\n"
+    "    if (instanced == 1) {\n"
+    "        vec3 axial = dot(position.xyz, instance_axis) * instance_axis;\n"
+    "        p = vec4(axial + (position.xyz - axial) * instance_posn.w + instance_posn.xyz, 1.0);\n"
+    "    }\n"
+    "    vec4 pv = (v_matrix * m_matrix * p);\n"
     "    vec4 ray = pv - (v_matrix * cyl_cam_pos);\n"
     "    vec3 rho_phi_z;\n"
     "    rho_phi_z[0] = sqrt (ray.x * ray.x + ray.y * ray.y);\n"
@@ -238,12 +259,12 @@ namespace mplot {
     "        gl_PointSize = 1;\n"
     "        gl_Position = vec4(x_s, y_s, -1.0, 1.0);\n"
     "        vertex.color = vec4(color, alpha);\n"
-    "        vertex.fragpos = vec3(m_matrix * position);\n"
+    "        vertex.fragpos = vec3(m_matrix * p);\n"
     "        vertex.normal = normalin;\n"
     "    } else {\n"
     "        gl_Position = vec4(0.0, 0.0, -100.0, 1.0);\n"
     "        vertex.color = vec4(color, 0.0);\n"
-    "        vertex.fragpos = vec3(m_matrix * position);\n"
+    "        vertex.fragpos = vec3(m_matrix * p);\n"
     "        vertex.normal = normalin;\n"
     "    }\n"
     "}\n";
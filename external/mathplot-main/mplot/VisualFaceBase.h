@@ -13,12 +13,16 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <limits>
+#include <mutex>
 #include <iostream>
 #include <utility>
 #include <fstream>
 
 #include <mplot/tools.h>
 #include <mplot/VisualCommon.h> // for visgl::CharInfo
+#include <mplot/GlyphAtlas.h>
 #include <mplot/VisualFont.h>
 #include <mplot/TextFeatures.h>
 
@@ -168,19 +172,98 @@ namespace mplot {
         struct VisualFaceBase
         {
             VisualFaceBase () {}
-            ~VisualFaceBase () {}
+            // The face is kept open so that glyphs can be loaded on demand
+            ~VisualFaceBase () { if (this->face != nullptr) { FT_Done_Face (this->face); } }
 
             //! Set true for informational/debug messages
             static constexpr bool debug_visualface = false;
 
             //! The FT_Face that we're managing
-            FT_Face face;
+            FT_Face face = nullptr;
 
-            //! The OpenGL character info stuff
+            //! The OpenGL character info stuff. Holds the glyphs loaded so far.
             std::map<char32_t, mplot::visgl::CharInfo> glchars;
 
+            //! All the glyph bitmaps of this face, packed into one image
+            mplot::visgl::GlyphAtlas atlas;
+
+            //! The ID of the texture that holds a copy of the atlas
+            unsigned int atlas_texture = 0;
+
+            /*!
+             * Return the info for the character c. If c has not been used before, its glyph is
+             * rendered into the atlas (which will need to be uploaded to atlas_texture before it
+             * is drawn). A character that is not in the face gets an empty CharInfo.
+             *
+             * glyph() may be called from several threads (texts can be laid out on model-building
+             * worker threads). The returned reference remains valid as glyphs are added.
+             */
+            const mplot::visgl::CharInfo& glyph (const char32_t c)
+            {
+                std::lock_guard<std::mutex> lk (this->glyph_mutex);
+                return this->glyph_unlocked (c);
+            }
+
+            //! Load the glyph of each character in txt
+            void glyphs (const std::basic_string<char32_t>& txt)
+            {
+                std::lock_guard<std::mutex> lk (this->glyph_mutex);
+                for (auto c : txt) { this->glyph_unlocked (c); }
+            }
+
+            //! Get the atlas size and generation, with which texture coordinates are computed
+            void atlas_info (sm::vec<int, 2>& size, unsigned int& generation)
+            {
+                std::lock_guard<std::mutex> lk (this->glyph_mutex);
+                size = { this->atlas.width(), this->atlas.height() };
+                generation = this->atlas.generation();
+            }
+
         protected:
 
+            //! Guards glchars, atlas and the FT_Face
+            std::mutex glyph_mutex;
+
+            //! glyph(), for a caller that holds glyph_mutex
+            const mplot::visgl::CharInfo& glyph_unlocked (const char32_t c)
+            {
+                auto gi = this->glchars.find (c);
+                if (gi != this->glchars.end()) { return gi->second; }
+
+                mplot::visgl::CharInfo glchar = { this->atlas_texture, {0, 0}, {0, 0}, 0u, {0, 0, 0, 0} };
+                // Check glyph index first, if it's 0 it's a blank
+                if (this->face != nullptr && FT_Get_Char_Index (this->face, c) != 0) {
+                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
+                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
+                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
+                    } else {
+                        const FT_Bitmap& bm = this->face->glyph->bitmap;
+                        glchar.size = { static_cast<int>(bm.width), static_cast<int>(bm.rows) };
+                        glchar.bearing = { this->face->glyph->bitmap_left, this->face->glyph->bitmap_top };
+                        glchar.advance = static_cast<unsigned int>(this->face->glyph->advance.x);
+                        glchar.atlas_rect = this->atlas.add (static_cast<int>(bm.width), static_cast<int>(bm.rows),
+                                                             bm.buffer, bm.pitch);
+                    }
+                }
+
+                if constexpr (debug_visualface == true) {
+                    std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
+                              << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
+                              << ", Advance:" << glchar.advance << ", Atlas rect:" << glchar.atlas_rect << std::endl;
+                }
+                return this->glchars.emplace (c, glchar).first->second;
+            }
+
+            //! The atlas generation last copied into atlas_texture
+            unsigned int texture_generation = std::numeric_limits<unsigned int>::max();
+
+            //! Load the printable ASCII characters, which most texts will use
+            void load_ascii()
+            {
+                std::lock_guard<std::mutex> lk (this->glyph_mutex);
+                for (char32_t c = 32; c < 127; ++c) { this->glyph_unlocked (c); }
+            }
+
             void init_common (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype)
             {
                 std::string fontpath = "";
@@ -38,68 +38,70 @@ namespace mplot {
              * VisualResources holds a map of VisualFace instances, to avoid many copies
              * of font textures for separate VisualTextModel instances which might have
              * the same pixel size.
+             *
+             * The glyphs are packed into one atlas texture. The printable ASCII glyphs are loaded
+             * here; any others are loaded when they are first used (see prepare()).
              */
             VisualFaceNoMX (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype)
             {
                 this->init_common (_font, fontpixels, ft_freetype);
 
-                // How far to loop. In principle, up to 21 bits worth - that's 2097151 possible characters!
-                for (char32_t c = 0; c < 2097151; c++) {
-                    // Check glyph index first, if it's 0 it's a blank so skip.
-                    if (FT_Get_Char_Index (this->face, c) == 0) { continue; }
-
-                    // load character glyph
-                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
-                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
-                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
-                        continue;
-                    }
-
-                    // generate texture
-                    unsigned int texture = 0;
-
-                    glGenTextures (1, &texture);
-                    glBindTexture (GL_TEXTURE_2D, texture);
-                    glTexImage2D(
-                        GL_TEXTURE_2D,
-                        0,
-                        GL_RED,
-                        this->face->glyph->bitmap.width,
-                        this->face->glyph->bitmap.rows,
-                        0,
-                        GL_RED,
-                        GL_UNSIGNED_BYTE,
-                        this->face->glyph->bitmap.buffer
-                        );
-                    // set texture options
-                    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
+                // Other glyphs are added to the atlas as they are first used
+                this->load_ascii();
+                // The texture is created by the first upload_atlas() call on the render thread,
+                // so that a face can also be set up on a model-building worker thread
+                this->upload_atlas();
+            }
 
-                    // now store character for later use
-                    mplot::visgl::CharInfo glchar = {
-                        texture,
-                        {static_cast<int>(this->face->glyph->bitmap.width), static_cast<int>(this->face->glyph->bitmap.rows)}, // size
-                        {this->face->glyph->bitmap_left, this->face->glyph->bitmap_top}, // bearing
-                        static_cast<unsigned int>(this->face->glyph->advance.x)          // advance
-                    };
+            //! Load the glyphs of txt and bring the atlas texture up to date
+            void prepare (const std::basic_string<char32_t>& txt)
+            {
+                this->glyphs (txt);
+                this->upload_atlas();
+            }
 
-                    if constexpr (debug_visualface == true) {
-                        std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
-                                  << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
-                                  << ", Advance:" << glchar.advance << std::endl;
-                    }
-                    this->glchars.insert (std::pair<char32_t, mplot::visgl::CharInfo>(c, glchar));
+            /*!
+             * Copy any changes in the atlas into atlas_texture. If the atlas has grown, the
+             * texture is re-allocated; otherwise, only the changed rows are copied. Does nothing
+             * on a model-building worker thread, which has no GL context.
+             */
+            void upload_atlas()
+            {
+                if (mplot::visgl::model_build_thread) { return; }
+                std::lock_guard<std::mutex> lk (this->glyph_mutex);
+                if (!this->atlas.dirty()) { return; }
+                if (this->atlas_texture == 0) { this->create_texture(); }
+                glBindTexture (GL_TEXTURE_2D, this->atlas_texture);
+                if (this->texture_generation != this->atlas.generation()) {
+                    glTexImage2D (GL_TEXTURE_2D, 0, GL_RED, this->atlas.width(), this->atlas.height(), 0,
+                                  GL_RED, GL_UNSIGNED_BYTE, this->atlas.pixels().data());
+                    this->texture_generation = this->atlas.generation();
+                } else {
+                    sm::vec<int, 2> rows = this->atlas.dirty_rows();
+                    glTexSubImage2D (GL_TEXTURE_2D, 0, 0, rows[0], this->atlas.width(), rows[1] - rows[0],
+                                     GL_RED, GL_UNSIGNED_BYTE,
+                                     this->atlas.pixels().data() + static_cast<std::size_t>(rows[0]) * this->atlas.width());
                 }
-
-                glBindTexture(GL_TEXTURE_2D, 0);
-
-                // At this point could FT_Done_Face() etc, I think. as we no longer do anything Freetypey with it.
-                FT_Done_Face (this->face);
+                glBindTexture (GL_TEXTURE_2D, 0);
+                this->atlas.clear_dirty();
             }
 
             ~VisualFaceNoMX() {}
+
+        private:
+            //! Create atlas_texture and record it in the glyphs' CharInfo
+            void create_texture()
+            {
+                glGenTextures (1, &this->atlas_texture);
+                glBindTexture (GL_TEXTURE_2D, this->atlas_texture);
+                // set texture options
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
+                glBindTexture (GL_TEXTURE_2D, 0);
+                for (auto& gc : this->glchars) { gc.second.textureID = this->atlas_texture; }
+            }
         };
     } // namespace gl
 } // namespace mplot
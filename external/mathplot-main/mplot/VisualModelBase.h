@@ -63,7 +63,8 @@ namespace mplot {
         twodimensional,         // If true, then this VisualModel should always be viewed in a plane - it's a 2D model
         hide,                   // If true, then calls to VisualModel::render should return
         show_bb,                // If true, draw vertices/indices for the bounding box frame
-        compute_bb              // For some models, it's not useful to compute the bounding box (e.g. coordinate arrows)
+        compute_bb,             // For some models, it's not useful to compute the bounding box (e.g. coordinate arrows)
+        batch_texts             // If true, merge the texts into one mesh per font face and draw each with one call
     };
 
     //! Forward declaration of a Visual class
@@ -122,6 +123,19 @@ namespace mplot {
             for (std::size_t i = 0; i < this->vertexPositions.size(); i += 3) {
                 this->bb.update (sm::vec<float>{ vertexPositions[i], vertexPositions[i+1], vertexPositions[i+2] });
             }
+            for (const auto& im : this->instmeshes) {
+                // A box around each instance that contains the scaled mesh
+                float mesh_r = 0.0f;
+                for (std::size_t i = 0; i < im.vertexPositions.size(); i += 3) {
+                    mesh_r = std::max (mesh_r, sm::vec<float>{ im.vertexPositions[i], im.vertexPositions[i+1], im.vertexPositions[i+2] }.length());
+                }
+                for (std::size_t i = 0; i < im.instancePositions.size(); i += 4) {
+                    sm::vec<float> ip = { im.instancePositions[i], im.instancePositions[i+1], im.instancePositions[i+2] };
+                    const float r = mesh_r * std::max (std::abs (im.instancePositions[i+3]), 1.0f);
+                    this->bb.update (ip - r);
+                    this->bb.update (ip + r);
+                }
+            }
             // After finding the bounding box, make up the vertices to display it:
             this->computeBoundingBox();
         }
@@ -132,9 +146,36 @@ namespace mplot {
          */
         virtual void reinit_buffers() = 0;
 
-        //! reinit ONLY vertexColors buffer
+        /*!
+         * reinit ONLY vertexColors buffer. If the number of vertices has not changed, the
+         * existing GL buffer is overwritten in place.
+         */
         virtual void reinit_colour_buffer() = 0;
 
+        //! reinit ONLY vertexPositions buffer (for models whose vertices move, but whose indices do not change)
+        virtual void reinit_position_buffer() = 0;
+
+        //! reinit ONLY vertexNormals buffer
+        virtual void reinit_normal_buffer() = 0;
+
+        /*!
+         * Upload only the tail of the vertex and index arrays. Use this when vertices have been
+         * appended to vertexPositions/Colors/Normals and indices since the last upload, starting
+         * at vertex-float index vstart and index istart. The GL buffers are grown geometrically
+         * when they are too small, so that streaming data costs O(new data) per call.
+         */
+        virtual void reinit_buffers_tail (const std::size_t vstart, const std::size_t istart) = 0;
+
+        //! Upload ONLY the per-instance data (instancePositions/Colors) of the instanced meshes
+        virtual void reinit_instance_buffers() = 0;
+
+        /*!
+         * Upload only the instances that were added (with instanced_mesh::add_instance) since the
+         * last upload. Instances that were already uploaded must not have changed. Like
+         * reinit_buffers_tail, the buffers grow geometrically, so streaming costs O(new instances).
+         */
+        virtual void reinit_instance_buffers_tail() = 0;
+
         virtual void clearTexts() = 0;
 
         //! Clear out the model, *including text models*
@@ -144,6 +185,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            for (auto& im : this->instmeshes) { im.clear(); }
             this->clearTexts();
             this->idx = 0u;
             // Clear bounding box
@@ -165,6 +207,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            for (auto& im : this->instmeshes) { im.clear(); }
 
             // Clear any bounding box too
             this->vpos_bb.clear();
@@ -192,6 +235,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            for (auto& im : this->instmeshes) { im.clear(); }
 
             this->clearTexts();
             this->idx = 0u;
@@ -865,6 +909,7 @@ namespace mplot {
             _flags.set (vm_bools::hide, false);
             _flags.set (vm_bools::show_bb, false);
             _flags.set (vm_bools::compute_bb, true);
+            _flags.set (vm_bools::batch_texts, false);
             return _flags;
         }
 
@@ -882,6 +927,15 @@ namespace mplot {
         void twodimensional (const bool val) { this->flags.set (vm_bools::twodimensional, val); }
         bool twodimensional() const { return this->flags.test (vm_bools::twodimensional); }
 
+        /*!
+         * Draw this model's texts in batches. The texts are merged into one mesh per font face
+         * (texts with the same font and font resolution share a face) and each mesh is drawn
+         * with a single call. The meshes are rebuilt when a text changes. Useful for models with
+         * many labels, such as GraphVisual.
+         */
+        void batch_texts (const bool val) { this->flags.set (vm_bools::batch_texts, val); }
+        bool batch_texts() const { return this->flags.test (vm_bools::batch_texts); }
+
         //! Getter for vertex positions (for mplot::NormalsVisual)
         std::vector<float> getVertexPositions() { return this->vertexPositions; }
         //! Getter for vertex normals (for mplot::NormalsVisual)
@@ -913,6 +967,18 @@ namespace mplot {
         //! Vertex Buffer Objects stored in an array
         std::unique_ptr<GLuint[]> vbos;
 
+        //! The allocated size, in bytes, of each of the GL buffers in vbos (see reinit_buffers_tail)
+        std::array<std::size_t, numVBO> vbo_capacity = {};
+
+        //! Record the sizes of the buffers after a whole-buffer upload
+        void set_vbo_capacity()
+        {
+            this->vbo_capacity[posnVBO] = this->vertexPositions.size() * sizeof(float);
+            this->vbo_capacity[normVBO] = this->vertexNormals.size() * sizeof(float);
+            this->vbo_capacity[colVBO] = this->vertexColors.size() * sizeof(float);
+            this->vbo_capacity[idxVBO] = this->indices.size() * sizeof(GLuint);
+        }
+
         //! CPU-side data for indices
         std::vector<GLuint> indices = {};
         //! CPU-side data for vertex positions
@@ -922,6 +988,118 @@ namespace mplot {
         //! CPU-side data for vertex colours
         std::vector<float> vertexColors = {};
 
+        /*!
+         * A mesh that is drawn many times with a single instanced draw call. The mesh is a 'unit'
+         * marker centred on the origin. The shader translates instance i to
+         * instancePositions[4i..4i+2], scales it by instancePositions[4i+3] and colours it with
+         * instanceColors[3i..3i+2]. This is how ScatterVisual and GraphVisual draw many identical
+         * markers without repeating the marker's vertices for every data point. Changing the
+         * instance data requires only reinit_instance_buffers().
+         *
+         * Instanced meshes require the default shaders (or shaders that implement the 'instanced'
+         * uniform in the same way) and are not written out by Visual::savegltf().
+         */
+        struct instanced_mesh
+        {
+            //! The unit mesh. It has no colours; these come from instanceColors.
+            std::vector<float> vertexPositions = {};
+            std::vector<float> vertexNormals = {};
+            std::vector<GLuint> indices = {};
+            //! Four floats per instance: the position (x,y,z) and scale of the mesh
+            std::vector<float> instancePositions = {};
+            //! Three floats per instance: the colour
+            std::vector<float> instanceColors = {};
+            //! The mesh is not scaled along this unit vector. If zero, scaling is uniform.
+            sm::vec<float, 3> axis = {};
+
+            //! The vertex array object and buffers (see InstVBOPos), created in postVertexInit()
+            GLuint vao = 0;
+            std::array<GLuint, 5> vbos = {};
+            //! The allocated size, in instances, of the instance buffers
+            std::size_t instance_capacity = 0;
+            //! The number of instances in the instance buffers after the last upload
+            std::size_t instances_uploaded = 0;
+
+            std::size_t num_instances() const { return this->instanceColors.size() / 3u; }
+
+            void add_instance (const sm::vec<float>& posn, const float scale, const std::array<float, 3>& clr)
+            {
+                this->instancePositions.insert (this->instancePositions.end(), { posn[0], posn[1], posn[2], scale });
+                this->instanceColors.insert (this->instanceColors.end(), clr.begin(), clr.end());
+            }
+
+            void clear_instances()
+            {
+                this->instancePositions.clear();
+                this->instanceColors.clear();
+                this->instances_uploaded = 0;
+            }
+
+            //! Clear the mesh and the instances, but not the GL objects, which may be re-used
+            void clear()
+            {
+                this->vertexPositions.clear();
+                this->vertexNormals.clear();
+                this->indices.clear();
+                this->clear_instances();
+                this->axis.zero();
+            }
+        };
+
+        //! Contains the positions within instanced_mesh::vbos of the different vertex buffer objects
+        enum InstVBOPos { instPosnVBO, instNormVBO, instIdxVBO, instOffsVBO, instColVBO, numInstVBO };
+
+        //! Instanced meshes, drawn after the vertices in vertexPositions etc.
+        std::vector<instanced_mesh> instmeshes = {};
+
+        //! Get instanced mesh i, creating it (and any before it) if necessary
+        instanced_mesh& instmesh (const std::size_t i)
+        {
+            if (this->instmeshes.size() <= i) { this->instmeshes.resize (i + 1u); }
+            return this->instmeshes[i];
+        }
+
+        //! True if any instanced mesh has instances to draw
+        bool has_instances() const
+        {
+            for (const auto& im : this->instmeshes) {
+                if (!im.indices.empty() && im.num_instances() > 0u) { return true; }
+            }
+            return false;
+        }
+
+        /*!
+         * Compute the unit mesh of im by calling compute(), which should call one or more of the
+         * compute* primitives (such as computeSphere) for a marker centred on the origin. The
+         * primitives' colours are discarded.
+         */
+        template <typename F>
+        void computeInstancedMesh (instanced_mesh& im, F compute)
+        {
+            std::vector<float> vp = {};
+            std::vector<float> vn = {};
+            std::vector<float> vc = {};
+            std::vector<GLuint> ind = {};
+            std::swap (vp, this->vertexPositions);
+            std::swap (vn, this->vertexNormals);
+            std::swap (vc, this->vertexColors);
+            std::swap (ind, this->indices);
+            const GLuint idx_saved = this->idx;
+            this->idx = 0u;
+
+            compute();
+
+            im.vertexPositions = std::move (this->vertexPositions);
+            im.vertexNormals = std::move (this->vertexNormals);
+            im.indices = std::move (this->indices);
+
+            this->vertexPositions = std::move (vp);
+            this->vertexNormals = std::move (vn);
+            this->vertexColors = std::move (vc);
+            this->indices = std::move (ind);
+            this->idx = idx_saved;
+        }
+
         // OpenGL arrays for the bounding box, if needed
         GLuint vao_bb = 0;
         std::unique_ptr<GLuint[]> vbos_bb;
@@ -975,6 +1153,19 @@ namespace mplot {
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
         virtual void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) = 0;
 
+        //! The state of one text when the text batches were made (see batch_texts())
+        struct batched_text
+        {
+            const void* text = nullptr;
+            std::size_t revision = 0;
+            std::array<float, 3> clr = {};
+            bool in_batch = false;
+            bool operator== (const batched_text&) const = default;
+        };
+        //! The state of each text when the text batches were made. If this differs from the
+        //! current state, the batches are rebuilt.
+        std::vector<batched_text> text_batch_state;
+
     protected:
         /**
          * START vertex/index computation code
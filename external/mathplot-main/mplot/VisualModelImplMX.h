@@ -42,12 +42,19 @@ namespace mplot {
         virtual ~VisualModelImpl() // clang gives -Wdelete-non-abstract-non-virtual-dtor without virtual
         {
             // Explicitly clear owned VisualTextModels
+            this->textbatches.clear();
             this->texts.clear();
             if (this->vbos != nullptr) {
                 GladGLContext* _glfn = this->get_glfn(this->parentVis);
                 _glfn->DeleteBuffers (this->numVBO, this->vbos.get());
                 _glfn->DeleteVertexArrays (1, &this->vao);
             }
+            for (auto& im : this->instmeshes) {
+                if (im.vao == 0) { continue; }
+                GladGLContext* _glfn = this->get_glfn(this->parentVis);
+                _glfn->DeleteBuffers (this->numInstVBO, im.vbos.data());
+                _glfn->DeleteVertexArrays (1, &im.vao);
+            }
         }
 
         /*!
@@ -104,6 +111,9 @@ namespace mplot {
             // Unbind only the vertex array (not the buffers, that causes GL_INVALID_ENUM errors)
             _glfn->BindVertexArray(0); // carefully unbind and rebind
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+            this->set_vbo_capacity();
+
+            this->setupInstancedMeshes();
 
             /*
              * Now do the same for the bounding box
@@ -165,6 +175,9 @@ namespace mplot {
 
             _glfn->BindVertexArray(0);                                // carefully unbind and rebind
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);  // carefully unbind and rebind
+            this->set_vbo_capacity();
+
+            this->setupInstancedMeshes();
 
             // Optional bounding box
             if (this->flags.test (vm_bools::compute_bb)) {
@@ -183,19 +196,46 @@ namespace mplot {
         }
 
         //! reinit ONLY vertexColors buffer
-        void reinit_colour_buffer() final
+        void reinit_colour_buffer() final { this->reinit_vertex_buffer (this->colVBO, this->vertexColors, visgl::colLoc); }
+
+        //! reinit ONLY vertexPositions buffer
+        void reinit_position_buffer() final { this->reinit_vertex_buffer (this->posnVBO, this->vertexPositions, visgl::posnLoc); }
+
+        //! reinit ONLY vertexNormals buffer
+        void reinit_normal_buffer() final { this->reinit_vertex_buffer (this->normVBO, this->vertexNormals, visgl::normLoc); }
+
+        /*!
+         * Upload only the vertices and indices that were appended from vstart/istart onwards.
+         * If a buffer is too small, it is re-allocated (orphaned) at double the required size
+         * with GL_DYNAMIC_DRAW, and the whole array is uploaded into it.
+         */
+        void reinit_buffers_tail (const std::size_t vstart, const std::size_t istart) final
         {
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
             if (this->flags.test (vm_bools::postVertexInitRequired) == true) { this->postVertexInit(); }
             GladGLContext* _glfn = this->get_glfn(this->parentVis);
-            // Now re-set up the VBOs
-            _glfn->BindVertexArray (this->vao);  // carefully unbind and rebind
-            this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
-            _glfn->BindVertexArray(0);  // carefully unbind and rebind
+            _glfn->BindVertexArray (this->vao);
+            this->streamVBO (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO], this->indices, istart, this->vbo_capacity[this->idxVBO]);
+            this->streamVBO (GL_ARRAY_BUFFER, this->vbos[this->posnVBO], this->vertexPositions, vstart, this->vbo_capacity[this->posnVBO]);
+            this->streamVBO (GL_ARRAY_BUFFER, this->vbos[this->normVBO], this->vertexNormals, vstart, this->vbo_capacity[this->normVBO]);
+            this->streamVBO (GL_ARRAY_BUFFER, this->vbos[this->colVBO], this->vertexColors, vstart, this->vbo_capacity[this->colVBO]);
+            _glfn->BindVertexArray(0);
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
         }
 
-        void clearTexts() { this->texts.clear(); }
+        //! Upload ONLY the per-instance data of the instanced meshes
+        void reinit_instance_buffers() final { this->reinitInstances (false); }
+
+        //! Upload only the instances added to the instanced meshes since the last upload
+        void reinit_instance_buffers_tail() final { this->reinitInstances (true); }
+
+        void clearTexts()
+        {
+            this->textbatches.clear();
+            this->textbatch_leads.clear();
+            this->text_batch_state.clear();
+            this->texts.clear();
+        }
 
         static constexpr bool debug_render = false;
         //! Render the VisualModel. Note that it is assumed that the OpenGL context has been
@@ -214,10 +254,7 @@ namespace mplot {
             // Ensure the correct program is in play for this VisualModel
             _glfn->UseProgram (this->get_gprog(this->parentVis));
 
-            if (!this->indices.empty()) {
-                // It is only necessary to bind the vertex array object before rendering
-                // (not the vertex buffer objects)
-                _glfn->BindVertexArray (this->vao);
+            if (!this->indices.empty() || this->has_instances()) {
 
                 // Pass this->float to GLSL so the model can have an alpha value.
                 GLint loc_a = _glfn->GetUniformLocation (this->get_gprog(this->parentVis), static_cast<const GLchar*>("alpha"));
@@ -236,11 +273,20 @@ namespace mplot {
                     std::cout << "VisualModel::render: model viewmatrix:\n" << this->viewmatrix << std::endl;
                 }
 
-                // Draw the triangles
-                _glfn->DrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), GL_UNSIGNED_INT, 0);
+                if (!this->indices.empty()) {
+                    // It is only necessary to bind the vertex array object before rendering
+                    // (not the vertex buffer objects)
+                    _glfn->BindVertexArray (this->vao);
 
-                // Unbind the VAO
-                _glfn->BindVertexArray(0);
+                    // Draw the triangles
+                    _glfn->DrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), GL_UNSIGNED_INT, 0);
+
+                    // Unbind the VAO
+                    _glfn->BindVertexArray(0);
+                }
+
+                // Draw each instanced mesh with one call
+                if (this->has_instances()) { this->renderInstances(); }
 
                 // Do the bounding box optionally
                 if (this->flags.test (vm_bools::compute_bb) && this->flags.test (vm_bools::show_bb) && !this->indices_bb.empty()) {
@@ -252,8 +298,12 @@ namespace mplot {
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
 
             // Now render any VisualTextModels
-            auto ti = this->texts.begin();
-            while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+            if (this->flags.test (vm_bools::batch_texts)) {
+                this->renderTextBatches();
+            } else {
+                auto ti = this->texts.begin();
+                while (ti != this->texts.end()) { (*ti)->render(); ti++; }
+            }
 
             _glfn->UseProgram (prev_shader);
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
@@ -395,6 +445,51 @@ namespace mplot {
         //! A vector of pointers to text models that should be rendered.
         std::vector<std::unique_ptr<mplot::VisualTextModel<glver>>> texts;
 
+        //! With batch_texts, the merged texts, one model per font face
+        std::vector<std::unique_ptr<mplot::VisualTextModel<glver>>> textbatches;
+        //! The first text in each batch, from which the batch takes its scene matrix
+        std::vector<const mplot::VisualTextModelBase<glver>*> textbatch_leads;
+
+        /*!
+         * Render the texts in batches, rebuilding the batches if any text has changed. Texts are
+         * grouped by font and font resolution (that is, by face, as each face has one atlas
+         * texture). The batch is drawn with its first text's scene matrix, so a text with a
+         * different scene matrix is drawn on its own.
+         */
+        void renderTextBatches()
+        {
+            std::map<std::pair<mplot::VisualFont, int>, std::vector<const mplot::VisualTextModelBase<glver>*>> groups;
+            std::vector<mplot::VisualTextModel<glver>*> singles;
+            std::vector<typename mplot::VisualModelBase<glver>::batched_text> state;
+            state.reserve (this->texts.size());
+            for (auto& t : this->texts) {
+                if (t->numQuads() == 0) { continue; }
+                const mplot::TextFeatures& tf = t->getTextFeatures();
+                auto& g = groups[{ tf.font, tf.fontres }];
+                const bool joins = g.empty() || g[0]->getSceneMatrix() == t->getSceneMatrix();
+                if (joins) { g.push_back (t.get()); } else { singles.push_back (t.get()); }
+                state.push_back ({ t.get(), t->getRevision(), t->clr_text, joins });
+            }
+
+            if (state != this->text_batch_state) {
+                this->textbatches.clear();
+                this->textbatch_leads.clear();
+                for (auto& g : groups) {
+                    auto tb = this->makeVisualTextModel (g.second[0]->getTextFeatures());
+                    tb->setupBatch (g.second);
+                    this->textbatches.push_back (std::move (tb));
+                    this->textbatch_leads.push_back (g.second[0]);
+                }
+                this->text_batch_state.swap (state);
+            }
+
+            for (std::size_t i = 0; i < this->textbatches.size(); ++i) {
+                this->textbatches[i]->setSceneMatrix (this->textbatch_leads[i]->getSceneMatrix());
+                this->textbatches[i]->render();
+            }
+            for (auto t : singles) { t->render(); }
+        }
+
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
         void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) final
         {
@@ -410,6 +505,148 @@ namespace mplot {
             _glfn->EnableVertexAttribArray (bufferAttribPosition);
             mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
         }
+
+        //! Create (once) the vertex array and buffers of each instanced mesh and upload all their data
+        void setupInstancedMeshes()
+        {
+            if (this->instmeshes.empty()) { return; }
+            GladGLContext* _glfn = this->get_glfn(this->parentVis);
+            for (auto& im : this->instmeshes) {
+                if (im.vao == 0) {
+                    _glfn->GenVertexArrays (1, &im.vao);
+                    _glfn->GenBuffers (this->numInstVBO, im.vbos.data());
+                }
+                _glfn->BindVertexArray (im.vao);
+                _glfn->BindBuffer (GL_ELEMENT_ARRAY_BUFFER, im.vbos[this->instIdxVBO]);
+                _glfn->BufferData (GL_ELEMENT_ARRAY_BUFFER, im.indices.size() * sizeof(GLuint), im.indices.data(), GL_STATIC_DRAW);
+                this->setupVBO (im.vbos[this->instPosnVBO], im.vertexPositions, visgl::posnLoc);
+                this->setupVBO (im.vbos[this->instNormVBO], im.vertexNormals, visgl::normLoc);
+                // The colour and instance position attributes advance once per instance
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instColVBO]);
+                _glfn->VertexAttribPointer (visgl::colLoc, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                _glfn->EnableVertexAttribArray (visgl::colLoc);
+                _glfn->VertexAttribDivisor (visgl::colLoc, 1);
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instOffsVBO]);
+                _glfn->VertexAttribPointer (visgl::instPosnLoc, 4, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                _glfn->EnableVertexAttribArray (visgl::instPosnLoc);
+                _glfn->VertexAttribDivisor (visgl::instPosnLoc, 1);
+                im.instance_capacity = 0;
+                this->uploadInstances (im, 0u);
+            }
+            _glfn->BindVertexArray(0);
+            mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+        }
+
+        //! Upload all the instances, or (if tail_only) only those added since the last upload
+        void reinitInstances (const bool tail_only)
+        {
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->flags.test (vm_bools::postVertexInitRequired) == true) { this->postVertexInit(); }
+            GladGLContext* _glfn = this->get_glfn(this->parentVis);
+            for (auto& im : this->instmeshes) {
+                if (im.vao == 0) {
+                    // A mesh that was added after the last full upload
+                    this->setupInstancedMeshes();
+                    break;
+                }
+                _glfn->BindVertexArray (im.vao);
+                this->uploadInstances (im, tail_only ? im.instances_uploaded : 0u);
+            }
+            _glfn->BindVertexArray(0);
+            mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+        }
+
+        /*!
+         * Upload the instance data of im from instance number from onwards. im's vertex array must
+         * be bound. If the buffers are too small, they are re-allocated at double the required
+         * size (as in streamVBO) and all the instances are uploaded into them. Otherwise, only
+         * instances from..end are written, with BufferSubData.
+         */
+        void uploadInstances (typename mplot::VisualModelBase<glver>::instanced_mesh& im, std::size_t from)
+        {
+            GladGLContext* _glfn = this->get_glfn(this->parentVis);
+            const std::size_t n = im.num_instances();
+            if (n > im.instance_capacity) {
+                // Orphan the old storage and allocate with room to grow
+                im.instance_capacity = 2u * n;
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instOffsVBO]);
+                _glfn->BufferData (GL_ARRAY_BUFFER, im.instance_capacity * 4u * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instColVBO]);
+                _glfn->BufferData (GL_ARRAY_BUFFER, im.instance_capacity * 3u * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+                from = 0u;
+            }
+            if (n > from) {
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instOffsVBO]);
+                _glfn->BufferSubData (GL_ARRAY_BUFFER, from * 4u * sizeof(float), (n - from) * 4u * sizeof(float),
+                                      im.instancePositions.data() + 4u * from);
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, im.vbos[this->instColVBO]);
+                _glfn->BufferSubData (GL_ARRAY_BUFFER, from * 3u * sizeof(float), (n - from) * 3u * sizeof(float),
+                                      im.instanceColors.data() + 3u * from);
+            }
+            im.instances_uploaded = n;
+            mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+        }
+
+        //! Draw the instanced meshes. The program's alpha and matrix uniforms must already be set.
+        void renderInstances()
+        {
+            GladGLContext* _glfn = this->get_glfn (this->parentVis);
+            GLuint prog = this->get_gprog (this->parentVis);
+            GLint loc_inst = _glfn->GetUniformLocation (prog, static_cast<const GLchar*>("instanced"));
+            if (loc_inst == -1) { return; } // The shader program can't draw instanced meshes
+            GLint loc_axis = _glfn->GetUniformLocation (prog, static_cast<const GLchar*>("instance_axis"));
+            _glfn->Uniform1i (loc_inst, 1);
+            for (const auto& im : this->instmeshes) {
+                if (im.vao == 0 || im.indices.empty() || im.num_instances() == 0u) { continue; }
+                if (loc_axis != -1) { _glfn->Uniform3fv (loc_axis, 1, im.axis.data()); }
+                _glfn->BindVertexArray (im.vao);
+                _glfn->DrawElementsInstanced (GL_TRIANGLES, static_cast<GLsizei>(im.indices.size()), GL_UNSIGNED_INT, 0,
+                                              static_cast<GLsizei>(im.num_instances()));
+            }
+            _glfn->BindVertexArray(0);
+            _glfn->Uniform1i (loc_inst, 0);
+        }
+
+        /*!
+         * Re-upload the vertex array dat into the buffer vbos[vbo]. If the buffer is already large
+         * enough, its content is overwritten in place with BufferSubData, otherwise it is
+         * re-allocated.
+         */
+        void reinit_vertex_buffer (const unsigned int vbo, std::vector<float>& dat, const unsigned int attribLocn)
+        {
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->flags.test (vm_bools::postVertexInitRequired) == true) { this->postVertexInit(); }
+            GladGLContext* _glfn = this->get_glfn(this->parentVis);
+            _glfn->BindVertexArray (this->vao);  // carefully unbind and rebind
+            const std::size_t sz = dat.size() * sizeof(float);
+            if (sz <= this->vbo_capacity[vbo]) {
+                _glfn->BindBuffer (GL_ARRAY_BUFFER, this->vbos[vbo]);
+                _glfn->BufferSubData (GL_ARRAY_BUFFER, 0, sz, dat.data());
+            } else {
+                this->setupVBO (this->vbos[vbo], dat, attribLocn);
+                this->vbo_capacity[vbo] = sz;
+            }
+            _glfn->BindVertexArray(0);  // carefully unbind and rebind
+            mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+        }
+
+        //! Write dat[from..end) into the buffer buf, growing the buffer if its capacity is too small
+        template <typename T>
+        void streamVBO (const GLenum target, const GLuint buf, const std::vector<T>& dat, std::size_t from, std::size_t& capacity)
+        {
+            const std::size_t sz = dat.size() * sizeof(T);
+            GladGLContext* _glfn = this->get_glfn(this->parentVis);
+            _glfn->BindBuffer (target, buf);
+            if (sz > capacity) {
+                // Orphan the old storage and allocate with room to grow
+                capacity = 2u * sz;
+                _glfn->BufferData (target, capacity, nullptr, GL_DYNAMIC_DRAW);
+                from = 0u;
+            }
+            const std::size_t offset = from * sizeof(T);
+            if (sz > offset) { _glfn->BufferSubData (target, offset, sz - offset, dat.data() + from); }
+            mplot::gl::Util::checkError (__FILE__, __LINE__, _glfn);
+        }
     };
 
 } // namespace mplot
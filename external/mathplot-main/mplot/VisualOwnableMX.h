@@ -73,6 +73,8 @@ namespace mplot {
         //! Deconstruct gl memory/context
         void deconstructCommon()
         {
+            // Finish with the threads that build VisualModels before deconstructing models
+            this->stopBuilders();
             // Explicitly deconstruct any owned VisualModels
             this->vm.clear();
             // Explicitly deconstruct coordArrows, textModel and texts here
@@ -169,6 +171,9 @@ namespace mplot {
         {
             this->setContext();
 
+            // Bring any VisualModels that were built on worker threads into the scene
+            this->adoptBuiltModels();
+
             if (this->ptype == perspective_type::orthographic || this->ptype == perspective_type::perspective) {
                 if (this->active_gprog != mplot::visgl::graphics_shader_type::projection2d) {
                     if (this->shaders.gprog) { this->glfn->DeleteProgram (this->shaders.gprog); }
@@ -15,6 +15,7 @@
 #include <set>
 #include <stdexcept>
 #include <memory>
+#include <mutex>
 #include <mplot/gl/version.h>
 #include <mplot/VisualFont.h>
 // FreeType for text rendering
@@ -45,6 +46,10 @@ namespace mplot {
         //! FreeType library object
         std::map<mplot::VisualBase<glver>*, FT_Library> freetypes;
 
+        //! Guards faces (in the derived classes), which may be looked up by text models that are
+        //! being built on worker threads (see VisualBase::addVisualModelAsync)
+        std::mutex faces_mutex;
+
     public:
         VisualResourcesBase(const VisualResourcesBase<glver>&) = delete;
         VisualResourcesBase& operator=(const VisualResourcesBase<glver> &) = delete;
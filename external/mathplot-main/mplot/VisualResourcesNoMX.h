@@ -82,6 +82,7 @@ namespace mplot {
         //! resolution, \a fontpixels and the given window (i.e. OpenGL context) \a _win.
         mplot::visgl::VisualFaceNoMX* getVisualFace (mplot::VisualFont font, unsigned int fontpixels, mplot::VisualBase<glver>* _vis)
         {
+            std::lock_guard<std::mutex> lk (this->faces_mutex);
             mplot::visgl::VisualFaceNoMX* rtn = nullptr;
             auto key = std::make_tuple(font, fontpixels, _vis);
             try {
@@ -101,6 +102,7 @@ namespace mplot {
         //! Loop through this->faces clearing out those associated with the given mplot::Visual
         void clearVisualFaces (mplot::VisualBase<glver>* _vis) final
         {
+            std::lock_guard<std::mutex> lk (this->faces_mutex);
             auto f = this->faces.begin();
             while (f != this->faces.end()) {
                 // f->first is a key. If its third, Visual<>* element == _vis, then delete and erase
@@ -25,6 +25,7 @@
 #include <sm/mathconst>
 
 #include <mplot/VisualCommon.h>
+#include <mplot/VisualFaceBase.h>
 #include <mplot/unicode.h>
 #include <mplot/TextGeometry.h>
 #include <mplot/TextFeatures.h>
@@ -61,7 +62,11 @@ namespace mplot {
         }
 
         //! Setter for VisualTextModel::viewmatrix, the model view
-        void setViewMatrix (const sm::mat44<float>& mv) { this->viewmatrix = mv; }
+        void setViewMatrix (const sm::mat44<float>& mv)
+        {
+            this->viewmatrix = mv;
+            ++this->revision;
+        }
 
         //! Setter for VisualTextModel::scenematrix, the scene view
         void setSceneMatrix (const sm::mat44<float>& sv) { this->scenematrix = sv; }
@@ -96,10 +101,15 @@ namespace mplot {
         {
             this->viewmatrix.setToIdentity();
             this->viewmatrix.translate (v0);
+            ++this->revision;
         }
 
         //! Add a translation to the model view matrix
-        void addViewTranslation (const sm::vec<float>& v0) { this->viewmatrix.pretranslate (v0); }
+        void addViewTranslation (const sm::vec<float>& v0)
+        {
+            this->viewmatrix.pretranslate (v0);
+            ++this->revision;
+        }
 
         //! Set a rotation (only) into the model view matrix
         void setViewRotation (const sm::quaternion<float>& r)
@@ -108,10 +118,27 @@ namespace mplot {
             this->viewmatrix.setToIdentity();
             this->viewmatrix.translate (tr);
             this->viewmatrix.rotate (r);
+            ++this->revision;
         }
 
         //! Apply a further rotation to the model view matrix
-        void addViewRotation (const sm::quaternion<float>& r) { this->viewmatrix.rotate (r); }
+        void addViewRotation (const sm::quaternion<float>& r)
+        {
+            this->viewmatrix.rotate (r);
+            ++this->revision;
+        }
+
+        //! Getter for the scene matrix
+        const sm::mat44<float>& getSceneMatrix() const { return this->scenematrix; }
+
+        //! Getter for the text features (font, font resolution and size)
+        const mplot::TextFeatures& getTextFeatures() const { return this->tfeatures; }
+
+        //! Incremented whenever the quads or the model view of this text change
+        std::size_t getRevision() const { return this->revision; }
+
+        //! The number of quads (one per visible character)
+        std::size_t numQuads() const { return this->quads.size(); }
 
         //! Compute the geometry for a sample text.
         virtual mplot::TextGeometry getTextGeometry (const std::string& _txt) = 0;
@@ -165,12 +192,6 @@ namespace mplot {
                 this->vertex_push (quad[6], quad[7],  quad[8],  this->vertexPositions); //3
                 this->vertex_push (quad[9], quad[10], quad[11], this->vertexPositions); //4
 
-                // Add the info for drawing the textures on the quads
-                this->vertex_push (0.0f, 1.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (0.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 1.0f, 0.0f, this->vertexTextures);
-
                 // All same colours
                 this->vertex_push (this->clr_backing, this->vertexColors);
                 this->vertex_push (this->clr_backing, this->vertexColors);
@@ -195,6 +216,175 @@ namespace mplot {
                 ib -= 3;
                 this->indices.push_back (ib);   // 0
             }
+
+            // Add the info for drawing the textures on the quads
+            this->computeTextureCoords();
+        }
+
+        /*!
+         * (Re)compute vertexTextures, the atlas texture coordinates of each quad's corners. These
+         * depend on the atlas size, so must be recomputed if the face's atlas grows.
+         */
+        void computeTextureCoords()
+        {
+            this->vertexTextures.resize (12 * this->quad_rects.size());
+            const float aw = static_cast<float>(this->atlas_size[0]);
+            const float ah = static_cast<float>(this->atlas_size[1]);
+            for (std::size_t qi = 0; qi < this->quad_rects.size(); ++qi) {
+                const sm::vec<int, 4>& r = this->quad_rects[qi];
+                const float u0 = r[0] / aw;
+                const float u1 = (r[0] + r[2]) / aw;
+                // v increases down the atlas image, from the top of the glyph to its bottom
+                const float v0 = r[1] / ah;
+                const float v1 = (r[1] + r[3]) / ah;
+                // Bottom left, top left, top right, bottom right, as for the quad vertices
+                const std::array<float, 12> uv = { u0, v1, 0.0f,  u0, v0, 0.0f,  u1, v0, 0.0f,  u1, v1, 0.0f };
+                std::copy (uv.begin(), uv.end(), this->vertexTextures.begin() + 12 * qi);
+            }
+        }
+
+        /*!
+         * With glyph information from the face f, set up this->quads and this->quad_rects for
+         * this->txt and initialize the vertices. The glyphs must already be in f's atlas.
+         */
+        void layoutText (mplot::visgl::VisualFaceBase* f)
+        {
+            this->quads.clear();
+            this->quad_rects.clear();
+            this->batched = false;
+            // Our string of letters starts at this location
+            float letter_pos = 0.0f;
+            float letter_y = 0.0f;
+            float text_epsilon = 0.0f;
+            for (std::basic_string<char32_t>::const_iterator c = this->txt.begin(); c != this->txt.end(); c++) {
+
+                if (*c == '\n') {
+                    // Skip newline, but add a y offset and reset letter_pos
+                    letter_pos = 0.0f;
+                    const mplot::visgl::CharInfo& ch = f->glyph ('h');
+                    letter_y += this->line_spacing * -ch.size.y() * this->fontscale;
+                    continue;
+                }
+
+                // Add a quad to this->quads
+                const mplot::visgl::CharInfo& ci = f->glyph (*c);
+
+                float xpos = letter_pos + ci.bearing.x() * this->fontscale;
+                float ypos = letter_y - (ci.size.y() - ci.bearing.y()) * this->fontscale;
+                float w = ci.size.x() * this->fontscale;
+                float h = ci.size.y() * this->fontscale;
+
+                // Update extents
+                if (xpos < this->extents[0]) { this->extents[0] = xpos; } // left
+                if (xpos+w > this->extents[1]) { this->extents[1] = xpos+w; } // right
+                if (ypos < this->extents[2]) { this->extents[2] = ypos; } // bottom
+                if (ypos+h > this->extents[3]) { this->extents[3] = ypos+h; } // top
+
+                // What's the order of the vertices for the quads? It is:
+                // Bottom left, Top left, top right, bottom right.
+                std::array<float,12> tbox = { xpos,   ypos,     text_epsilon,
+                                              xpos,   ypos+h,   text_epsilon,
+                                              xpos+w, ypos+h,   text_epsilon,
+                                              xpos+w, ypos,     text_epsilon };
+                text_epsilon -= 10.0f * std::numeric_limits<float>::epsilon();
+                if constexpr (debug_textquads == true) {
+                    std::cout << "Text box added as quad from\n("
+                              << tbox[0] << "," << tbox[1] << "," << tbox[2]
+                              << ") to (" << tbox[3] << "," << tbox[4] << "," << tbox[5]
+                              << ") to (" << tbox[6] << "," << tbox[7] << "," << tbox[8]
+                              << ") to (" << tbox[9] << "," << tbox[10] << "," << tbox[11]
+                              << "). w="<<w<<", h="<<h<<"\n";
+                    std::cout << "Atlas rectangle for that character is: " << ci.atlas_rect << std::endl;
+                }
+                this->quads.push_back (tbox);
+                this->quad_rects.push_back (ci.atlas_rect);
+
+                // The value in ci.advance has to be divided by 64 to bring it into the
+                // same units as the ci.size and ci.bearing values.
+                letter_pos += ((ci.advance>>6)*this->fontscale);
+            }
+            f->atlas_info (this->atlas_size, this->atlas_generation);
+            ++this->revision;
+
+            // Ensure we've cleared out vertex info
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            this->vertexTextures.clear();
+            this->indices.clear();
+
+            this->initializeVertices();
+        }
+
+        /*!
+         * Merge the quads of the texts in members into this model's vertices. Each text's quads
+         * are transformed by its model view matrix, and its colour is written into the vertex
+         * colours, so that this model can draw all the texts with one call. The members must
+         * share the face f (that is, the same font and font resolution).
+         */
+        void layoutBatch (const std::vector<const VisualTextModelBase<glver>*>& members, mplot::visgl::VisualFaceBase* f)
+        {
+            this->txt.clear();
+            this->quads.clear();
+            this->quad_rects.clear();
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            this->vertexTextures.clear();
+            this->indices.clear();
+            this->viewmatrix.setToIdentity();
+            this->batched = true;
+
+            std::size_t nq = 0;
+            for (auto tm : members) { nq += tm->quads.size(); }
+            this->quads.reserve (nq);
+            this->quad_rects.reserve (nq);
+            this->vertexPositions.reserve (12 * nq);
+            this->vertexNormals.reserve (12 * nq);
+            this->vertexColors.reserve (12 * nq);
+            this->indices.reserve (6 * nq);
+
+            for (auto tm : members) {
+                for (std::size_t qi = 0; qi < tm->quads.size(); ++qi) {
+                    const std::array<float, 12>& q = tm->quads[qi];
+                    std::array<float, 12> tq;
+                    for (unsigned int j = 0; j < 12; j += 3) {
+                        sm::vec<float, 4> p = tm->viewmatrix * sm::vec<float>{ q[j], q[j + 1], q[j + 2] };
+                        tq[j] = p[0];
+                        tq[j + 1] = p[1];
+                        tq[j + 2] = p[2];
+                    }
+                    this->quads.push_back (tq);
+                    this->quad_rects.push_back (tm->quad_rects[qi]);
+                    for (unsigned int j = 0; j < 4; ++j) { this->vertex_push (tm->clr_text, this->vertexColors); }
+                }
+            }
+
+            f->atlas_info (this->atlas_size, this->atlas_generation);
+            ++this->revision;
+
+            // initializeVertices() pushes clr_backing colours, which are replaced here by the text colours
+            std::vector<float> colours;
+            colours.swap (this->vertexColors);
+            this->initializeVertices();
+            this->vertexColors.swap (colours);
+        }
+
+        /*!
+         * Compute the geometry of the text utxt, using the glyph information from the face f.
+         */
+        mplot::TextGeometry computeTextGeometry (const std::basic_string<char32_t>& utxt, mplot::visgl::VisualFaceBase* f)
+        {
+            mplot::TextGeometry geom;
+            for (std::basic_string<char32_t>::const_iterator c = utxt.begin(); c != utxt.end(); c++) {
+                const mplot::visgl::CharInfo& ci = f->glyph (*c);
+                float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
+                geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
+                float bearingy = ci.bearing.y() * this->fontscale;
+                geom.max_bearingy = (bearingy > geom.max_bearingy) ? bearingy : geom.max_bearingy;
+                geom.total_advance += ((ci.advance>>6)*this->fontscale);
+            }
+            return geom;
         }
 
         //! Common code to call after the vertices have been set up.
@@ -260,8 +450,20 @@ namespace mplot {
         //! VisualTextModel. setupText should modify these as it sets up quads. Order of
         //! numbers is left, right, bottom, top
         sm::vec<float, 4> extents = { 1e7, -1e7, 1e7, -1e7 };
-        //! The texture ID for each quad - so that we draw the right texture image over each quad.
-        std::vector<unsigned int> quad_ids = {};
+        //! The atlas rectangle for each quad - so that we draw the right glyph over each quad.
+        std::vector<sm::vec<int, 4>> quad_rects = {};
+        //! The size of the face's atlas when vertexTextures were computed
+        sm::vec<int, 2> atlas_size = { 1, 1 };
+        //! The generation of the face's atlas when vertexTextures were computed
+        unsigned int atlas_generation = 0;
+        //! Incremented when quads or viewmatrix change. See getRevision().
+        std::size_t revision = 0;
+        //! True if this model holds the merged quads of other texts (see layoutBatch). Its
+        //! vertex colours are then the texts' colours.
+        bool batched = false;
+        //! True if the text was set up on a model-building worker thread, which can't make GL
+        //! calls. postVertexInit() is then called by the first render().
+        bool postVertexInitRequired = false;
         //! Position within vertex buffer object (if I use an array of VBO)
         enum VBOPos { posnVBO, normVBO, colVBO, idxVBO, textureVBO, numVBO };
         //! The OpenGL Vertex Array Object
@@ -50,7 +50,8 @@ namespace mplot {
         //! Render the VisualTextModel
         void render() final
         {
-            if (this->hide == true) { return; }
+            if (this->hide == true || this->face == nullptr || this->quads.empty()) { return; }
+            if (this->postVertexInitRequired) { this->postVertexInit(); }
 
             GLint prev_shader;
             GLuint tshaderprog = this->get_tprog (this->parentVis);
@@ -72,23 +73,29 @@ namespace mplot {
             GLint loc_m = _glfn->GetUniformLocation (tshaderprog, static_cast<const GLchar*>("m_matrix"));
             if (loc_m != -1) { _glfn->UniformMatrix4fv (loc_m, 1, GL_FALSE, this->viewmatrix.mat.data()); }
 
+            // In a batch, the colour of each text is in its vertex colours
+            GLint loc_vc = _glfn->GetUniformLocation (tshaderprog, static_cast<const GLchar*>("vertexcolour"));
+            if (loc_vc != -1) { _glfn->Uniform1i (loc_vc, this->batched ? 1 : 0); }
+
             _glfn->ActiveTexture (GL_TEXTURE0);
 
             // It is only necessary to bind the vertex array object before rendering
             _glfn->BindVertexArray (this->vao);
 
-            // We have a max of (2^32)-1 characters. Should be enough.
-            for (unsigned int i = 0U; i < this->quads.size(); ++i) {
-                // Bind the right texture for the quad.
-                _glfn->BindTexture (GL_TEXTURE_2D, this->quad_ids[i]);
-                // This is 'draw a subset of the elements from the vertex array
-                // object'. You say how many indices to draw and which base *vertex* you
-                // start from. In my scheme, I have 4 vertices for each two triangles
-                // that are constructed. Thus, I draw 6 indices, but increment the base
-                // vertex by 4 for each letter.
-                _glfn->DrawElementsBaseVertex (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 4*i);
+            // Glyphs may have been added to the atlas since the quads were set up. If the atlas
+            // has grown, the texture coordinates have to be recomputed.
+            this->face->upload_atlas();
+            const unsigned int gen = this->atlas_generation;
+            this->face->atlas_info (this->atlas_size, this->atlas_generation);
+            if (this->atlas_generation != gen) {
+                this->computeTextureCoords();
+                this->setupVBO (this->vbos[this->textureVBO], this->vertexTextures, visgl::textureLoc);
             }
 
+            // All the glyphs are in one texture, so all the quads are drawn with one call
+            _glfn->BindTexture (GL_TEXTURE_2D, this->face->atlas_texture);
+            _glfn->DrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), GL_UNSIGNED_INT, 0);
+
             _glfn->BindVertexArray(0);
             _glfn->UseProgram (prev_shader);
 
@@ -107,16 +114,7 @@ namespace mplot {
             }
 
             // First convert string from ASCII/UTF-8 into Unicode.
-            std::basic_string<char32_t> utxt = mplot::unicode::fromUtf8(_txt);
-            for (std::basic_string<char32_t>::const_iterator c = utxt.begin(); c != utxt.end(); c++) {
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
-                float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
-                geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
-                float bearingy = ci.bearing.y() * this->fontscale;
-                geom.max_bearingy = (bearingy > geom.max_bearingy) ? bearingy : geom.max_bearingy;
-                geom.total_advance += ((ci.advance>>6)*this->fontscale);
-            }
-            return geom;
+            return this->computeTextGeometry (mplot::unicode::fromUtf8 (_txt), this->face);
         }
 
         //! Return the geometry for the stored txt
@@ -130,15 +128,7 @@ namespace mplot {
                                                                           this->get_glfn(this->parentVis));
             }
 
-            for (std::basic_string<char32_t>::const_iterator c = this->txt.begin(); c != this->txt.end(); c++) {
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
-                float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
-                geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
-                float bearingy = ci.bearing.y() * this->fontscale;
-                geom.max_bearingy = (bearingy > geom.max_bearingy) ? bearingy : geom.max_bearingy;
-                geom.total_advance += ((ci.advance>>6)*this->fontscale);
-            }
-            return geom;
+            return this->computeTextGeometry (this->txt, this->face);
         }
 
         //! For some reason, I can't place these setupText functions in the base class. Compiler
@@ -181,75 +171,41 @@ namespace mplot {
             }
 
             this->txt = _txt;
-            // With glyph information from txt, set up this->quads.
-            this->quads.clear();
-            this->quad_ids.clear();
-            // Our string of letters starts at this location
-            float letter_pos = 0.0f;
-            float letter_y = 0.0f;
-            float text_epsilon = 0.0f;
-            for (std::basic_string<char32_t>::const_iterator c = this->txt.begin(); c != this->txt.end(); c++) {
-
-                if (*c == '\n') {
-                    // Skip newline, but add a y offset and reset letter_pos
-                    letter_pos = 0.0f;
-                    mplot::visgl::CharInfo ch = this->face->glchars['h'];
-                    letter_y += this->line_spacing * -ch.size.y() * this->fontscale;
-                    continue;
-                }
-
-                // Add a quad to this->quads
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
-
-                float xpos = letter_pos + ci.bearing.x() * this->fontscale;
-                float ypos = letter_y - (ci.size.y() - ci.bearing.y()) * this->fontscale;
-                float w = ci.size.x() * this->fontscale;
-                float h = ci.size.y() * this->fontscale;
-
-                // Update extents
-                if (xpos < this->extents[0]) { this->extents[0] = xpos; } // left
-                if (xpos+w > this->extents[1]) { this->extents[1] = xpos+w; } // right
-                if (ypos < this->extents[2]) { this->extents[2] = ypos; } // bottom
-                if (ypos+h > this->extents[3]) { this->extents[3] = ypos+h; } // top
-
-                // What's the order of the vertices for the quads? It is:
-                // Bottom left, Top left, top right, bottom right.
-                std::array<float,12> tbox = { xpos,   ypos,     text_epsilon,
-                                              xpos,   ypos+h,   text_epsilon,
-                                              xpos+w, ypos+h,   text_epsilon,
-                                              xpos+w, ypos,     text_epsilon };
-                text_epsilon -= 10.0f * std::numeric_limits<float>::epsilon();
-                if constexpr (mplot::VisualTextModelBase<glver>::debug_textquads == true) {
-                    std::cout << "Text box added as quad from\n("
-                              << tbox[0] << "," << tbox[1] << "," << tbox[2]
-                              << ") to (" << tbox[3] << "," << tbox[4] << "," << tbox[5]
-                              << ") to (" << tbox[6] << "," << tbox[7] << "," << tbox[8]
-                              << ") to (" << tbox[9] << "," << tbox[10] << "," << tbox[11]
-                              << "). w="<<w<<", h="<<h<<"\n";
-                    std::cout << "Texture ID for that character is: " << ci.textureID << std::endl;
-                }
-                this->quads.push_back (tbox);
-                this->quad_ids.push_back (ci.textureID);
-
-                // The value in ci.advance has to be divided by 64 to bring it into the
-                // same units as the ci.size and ci.bearing values.
-                letter_pos += ((ci.advance>>6)*this->fontscale);
-            }
+            // Make sure that the glyphs are in the face's atlas texture, then set up this->quads
+            this->face->prepare (this->txt);
+            this->layoutText (this->face);
 
-            // Ensure we've cleared out vertex info
-            this->vertexPositions.clear();
-            this->vertexNormals.clear();
-            this->vertexColors.clear();
-            this->vertexTextures.clear();
-            this->indices.clear();
-
-            this->initializeVertices();
+            this->initBuffers();
+        }
 
-            this->postVertexInit();
+        /*!
+         * Make this text model a batch: a single mesh holding the quads of all the texts in
+         * members, which must have the same font and font resolution as this model. See
+         * VisualTextModelBase::layoutBatch.
+         */
+        void setupBatch (const std::vector<const VisualTextModelBase<glver>*>& members)
+        {
+            if (this->face == nullptr) {
+                this->face = VisualResourcesMX<glver>::i().getVisualFace (this->tfeatures, this->parentVis,
+                                                                          this->get_glfn(this->parentVis));
+            }
+            this->face->upload_atlas();
+            this->layoutBatch (members, this->face);
+            this->initBuffers();
         }
 
     protected:
 
+        //! Call postVertexInit, or leave it to render() on a model-building worker thread
+        void initBuffers()
+        {
+            if (mplot::visgl::model_build_thread) {
+                this->postVertexInitRequired = true;
+            } else {
+                this->postVertexInit();
+            }
+        }
+
         //! Common code to call after the vertices have been set up.
         void postVertexInit() final
         {
@@ -285,6 +241,8 @@ namespace mplot {
             // Possibly release (unbind) the vertex buffers, but have to unbind vertex
             // array object first.
             _glfn->BindVertexArray(0); // carefully unbind
+
+            this->postVertexInitRequired = false;
         }
 
     public:
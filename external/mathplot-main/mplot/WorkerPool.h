@@ -0,0 +1,101 @@
+/*!
+ * \file
+ *
+ * Declares a small pool of worker threads which is used to build the vertices of VisualModels
+ * away from the thread that owns the OpenGL context (see VisualBase::addVisualModelAsync).
+ *
+ * \date Oct 2026
+ */
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include <mplot/VisualCommon.h>
+
+namespace mplot {
+
+    namespace visgl {
+
+        /*!
+         * A fixed number of threads which run submitted jobs in the order that they were
+         * submitted. Each worker thread sets visgl::model_build_thread, so it must only be given
+         * jobs that make no OpenGL calls.
+         */
+        class worker_pool
+        {
+        public:
+            //! Start n threads. If n is 0, start one per hardware thread.
+            worker_pool (unsigned int n = 0)
+            {
+                if (n == 0) { n = std::thread::hardware_concurrency(); }
+                if (n == 0) { n = 1; }
+                this->threads.reserve (n);
+                for (unsigned int i = 0; i < n; ++i) { this->threads.emplace_back (&worker_pool::work, this); }
+            }
+
+            //! Run any jobs that are still queued, then join the threads
+            ~worker_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lk (this->jobs_mutex);
+                    this->stopping = true;
+                }
+                this->jobs_cv.notify_all();
+                for (auto& t : this->threads) { t.join(); }
+            }
+
+            worker_pool (const worker_pool&) = delete;
+            worker_pool& operator= (const worker_pool&) = delete;
+
+            //! Queue job. The returned future becomes ready when the job has run and passes on
+            //! any exception that the job threw.
+            template <typename F>
+            std::future<void> submit (F&& job)
+            {
+                auto task = std::make_shared<std::packaged_task<void()>> (std::forward<F>(job));
+                std::future<void> f = task->get_future();
+                {
+                    std::lock_guard<std::mutex> lk (this->jobs_mutex);
+                    this->jobs.emplace_back ([task]() { (*task)(); });
+                }
+                this->jobs_cv.notify_one();
+                return f;
+            }
+
+            unsigned int size() const { return static_cast<unsigned int>(this->threads.size()); }
+
+        private:
+            void work()
+            {
+                mplot::visgl::model_build_thread = true;
+                for (;;) {
+                    std::function<void()> job;
+                    {
+                        std::unique_lock<std::mutex> lk (this->jobs_mutex);
+                        this->jobs_cv.wait (lk, [this]() { return this->stopping || !this->jobs.empty(); });
+                        if (this->jobs.empty()) { return; } // stopping, with nothing left to do
+                        job = std::move (this->jobs.front());
+                        this->jobs.pop_front();
+                    }
+                    job();
+                }
+            }
+
+            std::vector<std::thread> threads;
+            std::deque<std::function<void()>> jobs;
+            std::mutex jobs_mutex;
+            std::condition_variable jobs_cv;
+            bool stopping = false;
+        };
+
+    } // namespace visgl
+} // namespace mplot
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <deque>
@@ -23,6 +25,7 @@
 
 #include <sm/range>
 #include <sm/algo>
+#include <sm/vec>
 #include <sm/vvec>
 
 namespace mplot::graphing {
@@ -208,4 +211,68 @@ namespace mplot::graphing {
         return mplot::graphing::maketicks<F> (rmin, rmax, realmin, realmax, _num_ticks_range);
     }
 
+    /*!
+     * Min/max decimation of a line of model-space graph coordinates for drawing.
+     *
+     * The x range [0, width] is divided into ncols columns (choose ncols to be the on-screen
+     * width of the graph in pixels). Consecutive coordinates in coords[start, end) that fall into
+     * the same column are replaced by the coordinates having the minimum and maximum y values,
+     * output in their original order. A series of 10 million points is thus drawn with no more
+     * than about 2 * ncols points, yet the envelope of the line is preserved at screen resolution.
+     *
+     * If flush is false, the final column (which may still receive more data, if data are being
+     * appended) is not output. The return value is the index of the first coordinate that was
+     * not consumed, so that a subsequent call can carry on from there. If flush is true, end is
+     * returned.
+     *
+     * Decimated coordinates are appended to out.
+     */
+    template <typename F>
+    static std::size_t decimate_minmax (const std::vector<sm::vec<F>>& coords, std::size_t start, std::size_t end,
+                                        const F width, const unsigned int ncols, const bool flush,
+                                        std::vector<sm::vec<F>>& out)
+    {
+        if (end > coords.size()) { end = coords.size(); }
+        if (start >= end) { return start; }
+        if (ncols == 0u || width <= F{0}) {
+            // No decimation possible, so pass all the coordinates through
+            out.insert (out.end(), coords.begin() + start, coords.begin() + end);
+            return end;
+        }
+
+        const F colwidth = width / static_cast<F>(ncols);
+        const int maxcol = static_cast<int>(ncols) - 1;
+        auto column_of = [colwidth, maxcol](const F x)
+        {
+            int c = static_cast<int>(std::floor (x / colwidth));
+            return c < 0 ? 0 : (c > maxcol ? maxcol : c);
+        };
+
+        std::size_t run_start = start;
+        while (run_start < end) {
+            // Find the run of coordinates that share one column
+            const int col = column_of (coords[run_start][0]);
+            std::size_t run_end = run_start + 1;
+            while (run_end < end && column_of (coords[run_end][0]) == col) { ++run_end; }
+
+            // The last run may be incomplete. Leave it for next time unless flushing.
+            if (run_end == end && !flush) { return run_start; }
+
+            std::size_t imin = run_start;
+            std::size_t imax = run_start;
+            for (std::size_t i = run_start + 1; i < run_end; ++i) {
+                if (coords[i][1] < coords[imin][1]) { imin = i; }
+                if (coords[i][1] > coords[imax][1]) { imax = i; }
+            }
+            if (imin == imax) {
+                out.push_back (coords[imin]);
+            } else {
+                out.push_back (coords[std::min (imin, imax)]);
+                out.push_back (coords[std::max (imin, imax)]);
+            }
+            run_start = run_end;
+        }
+        return end;
+    }
+
 } // namespace mplot::graphing
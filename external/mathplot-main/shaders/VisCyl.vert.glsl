@@ -15,11 +15,15 @@ uniform float cyl_radius = 0.005;
 uniform float cyl_height = 0.02;
 // Camera position
 uniform vec4 cyl_cam_pos = vec4(0);
+// Instanced meshes (see Visual.vert.glsl)
+uniform int instanced;
+uniform vec3 instance_axis;
 
 // My original inputs
 layout(location = 0) in vec4 position; // Attrib location 0. vertex position
 layout(location = 1) in vec4 normalin; // Attrib location 1. vertex normal
 layout(location = 2) in vec3 color;    // Attrib location 2. vertex colour
+layout(location = 4) in vec4 instance_posn; // Attrib location 4. instance position and scale
 
 out VERTEX
 {
@@ -33,8 +37,13 @@ void main (void)
     const float pi = 3.1415927;
     const float two_pi = 6.283185307;
     const float heading_offset = 1.570796327; // pi/2 but maybe pass in?
+    vec4 p = position;
+    if (instanced == 1) {
+        vec3 axial = dot(position.xyz, instance_axis) * instance_axis;
+        p = vec4(axial + (position.xyz - axial) * instance_posn.w + instance_posn.xyz, 1.0);
+    }
     // Transform vertex position with scene view and model view matrices
-    vec4 pv = (v_matrix * m_matrix * position);
+    vec4 pv = (v_matrix * m_matrix * p);
     vec4 ray = pv - (v_matrix * cyl_cam_pos);
     vec3 rho_phi_z; // polar coordinates of ray
     rho_phi_z[0] = sqrt (ray.x * ray.x + ray.y * ray.y);
@@ -53,12 +62,12 @@ void main (void)
         gl_PointSize = 1;
         gl_Position = vec4(x_s, y_s, -1.0, 1.0);
         vertex.color = vec4(color, alpha);
-        vertex.fragpos = vec3(m_matrix * position); // within-model position of fragment, used for lighting
+        vertex.fragpos = vec3(m_matrix * p); // within-model position of fragment, used for lighting
         vertex.normal = normalin;
     } else {
         gl_Position = vec4(0.0, 0.0, -100.0, 1.0);
         vertex.color = vec4(color, 0.0);
-        vertex.fragpos = vec3(m_matrix * position);
+        vertex.fragpos = vec3(m_matrix * p);
         vertex.normal = normalin;
     }
 }
@@ -1,12 +1,16 @@
 // The coded-in shaders tell non-Mac platforms that they use OpenGL 4.5, but Mac limited to 4.1
 #version 410
 in vec2 TexCoords;
+in vec3 VColor;
 out vec4 color;
 
 uniform sampler2D text;
 uniform vec3 textColor;
+// If 1, the text colour is taken from the vertex colours (as for a batch of texts)
+uniform int vertexcolour;
 
 void main()
 {
-    color = vec4(textColor, texture(text, TexCoords).r);
+    vec3 c = vertexcolour == 1 ? VColor : textColor;
+    color = vec4(c, texture(text, TexCoords).r);
 }
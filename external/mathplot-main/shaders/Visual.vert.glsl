@@ -10,10 +10,15 @@ uniform mat4 v_matrix; // scene view matrix
 uniform mat4 p_matrix; // projection matrix
 // alpha - to make a model see-through
 uniform float alpha;
+// When instanced is 1, position is a vertex of a unit mesh which is scaled and translated by
+// instance_posn. The mesh is not scaled along instance_axis (which is zero for uniform scaling).
+uniform int instanced;
+uniform vec3 instance_axis;
 
-layout(location = 0) in vec4 position; // Attrib location 0
-layout(location = 1) in vec4 normalin; // Attrib location 1
-layout(location = 2) in vec3 color;    // Attrib location 2
+layout(location = 0) in vec4 position;      // Attrib location 0
+layout(location = 1) in vec4 normalin;      // Attrib location 1
+layout(location = 2) in vec3 color;         // Attrib location 2 (per-instance when instanced)
+layout(location = 4) in vec4 instance_posn; // Attrib location 4. xyz: position, w: scale
 
 out VERTEX
 {
@@ -24,9 +29,14 @@ out VERTEX
 
 void main (void)
 {
-    gl_Position = (p_matrix * v_matrix * m_matrix * position);
+    vec4 p = position;
+    if (instanced == 1) {
+        vec3 axial = dot(position.xyz, instance_axis) * instance_axis;
+        p = vec4(axial + (position.xyz - axial) * instance_posn.w + instance_posn.xyz, 1.0);
+    }
+    gl_Position = (p_matrix * v_matrix * m_matrix * p);
     vertex.color = vec4(color, alpha);
-    vertex.fragpos = vec3(m_matrix * position);
+    vertex.fragpos = vec3(m_matrix * p);
     // Normals are all automatically computed, so there's no need for
     // this line and the cube program doesn't bother to pass in the
     // normals. Maybe required only for lighting?
@@ -0,0 +1,174 @@
+/*
+ * A Visual for tests that must run GL code without a window or a display. It creates a
+ * surfaceless EGL context (such as Mesa's llvmpipe software renderer provides) and renders into
+ * a framebuffer object, whose pixels can then be read back and compared.
+ *
+ * The Visual is a VisualOwnableMX or, if HEADLESS_NOMX is defined before this header is
+ * included, a VisualOwnableNoMX. Include this header before any other mplot header.
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+// There is no window. Define mplot::win_t before #including mplot/VisualOwnable[No]MX.h
+namespace mplot { struct headless_surface {}; using win_t = headless_surface; }
+
+#ifdef HEADLESS_NOMX
+# include <mplot/VisualOwnableNoMX.h>
+# define HEADLESS_GL(f) gl##f
+#else
+# include <mplot/VisualOwnableMX.h>
+# define HEADLESS_GL(f) this->glfn->f
+#endif
+
+#ifdef HEADLESS_NOMX
+using headless_visual_base = mplot::VisualOwnableNoMX<mplot::gl::version_4_1>;
+#else
+using headless_visual_base = mplot::VisualOwnableMX<mplot::gl::version_4_1>;
+#endif
+
+struct headless_visual : public headless_visual_base
+{
+    /*!
+     * Create the GL context and a width x height framebuffer to render into. If no context can
+     * be created, ready() returns false and the Visual must not be used.
+     */
+    headless_visual (const int width, const int height)
+    {
+        if (!this->create_context()) { return; }
+        this->init_glad (headless_visual::get_proc_address);
+        if (this->glfn_version == 0) { std::cout << "Failed to load the GL functions\n"; return; }
+        this->set_winsize (width, height);
+        this->init (&this->surface);
+        this->initialised = true;
+
+        HEADLESS_GL(GenFramebuffers) (1, &this->fbo);
+        HEADLESS_GL(BindFramebuffer) (GL_FRAMEBUFFER, this->fbo);
+        HEADLESS_GL(GenRenderbuffers) (2, this->rbo);
+        HEADLESS_GL(BindRenderbuffer) (GL_RENDERBUFFER, this->rbo[0]);
+        HEADLESS_GL(RenderbufferStorage) (GL_RENDERBUFFER, GL_RGBA8, width, height);
+        HEADLESS_GL(FramebufferRenderbuffer) (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->rbo[0]);
+        HEADLESS_GL(BindRenderbuffer) (GL_RENDERBUFFER, this->rbo[1]);
+        HEADLESS_GL(RenderbufferStorage) (GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        HEADLESS_GL(FramebufferRenderbuffer) (GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->rbo[1]);
+        this->have_fbo = HEADLESS_GL(CheckFramebufferStatus) (GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        if (!this->have_fbo) { std::cout << "Framebuffer is incomplete\n"; }
+    }
+
+    ~headless_visual()
+    {
+        if (this->initialised) {
+            HEADLESS_GL(DeleteFramebuffers) (1, &this->fbo);
+            HEADLESS_GL(DeleteRenderbuffers) (2, this->rbo);
+            this->deconstructCommon();
+        }
+        if (this->ctx != EGL_NO_CONTEXT) {
+            eglMakeCurrent (this->dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext (this->dpy, this->ctx);
+        }
+        if (this->dpy != EGL_NO_DISPLAY) { eglTerminate (this->dpy); }
+    }
+
+    //! True if the context and framebuffer were created
+    bool ready() const { return this->have_fbo; }
+
+    //! The RGBA pixels of the framebuffer, bottom row first
+    std::vector<std::uint8_t> pixels()
+    {
+        std::vector<std::uint8_t> px (4u * this->window_w * this->window_h, 0u);
+        HEADLESS_GL(Finish)();
+        HEADLESS_GL(ReadPixels) (0, 0, this->window_w, this->window_h, GL_RGBA, GL_UNSIGNED_BYTE, px.data());
+        return px;
+    }
+
+    //! Read n elements of type T back from the GL buffer buf, which is bound to target
+    template <typename T>
+    std::vector<T> read_buffer (const GLenum target, const GLuint buf, const std::size_t n)
+    {
+        std::vector<T> dat (n);
+        HEADLESS_GL(BindBuffer) (target, buf);
+        HEADLESS_GL(GetBufferSubData) (target, 0, n * sizeof(T), dat.data());
+        HEADLESS_GL(BindBuffer) (target, 0);
+        return dat;
+    }
+
+    //! The allocated size, in bytes, of the GL buffer buf, which is bound to target
+    GLint buffer_size (const GLenum target, const GLuint buf)
+    {
+        GLint sz = 0;
+        HEADLESS_GL(BindBuffer) (target, buf);
+        HEADLESS_GL(GetBufferParameteriv) (target, GL_BUFFER_SIZE, &sz);
+        HEADLESS_GL(BindBuffer) (target, 0);
+        return sz;
+    }
+
+    //! Count the pixels of a and b whose colours differ by more than tol in any channel
+    static std::size_t count_differences (const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b, const int tol = 0)
+    {
+        std::size_t nd = 0;
+        for (std::size_t i = 0; i + 3u < a.size() && i + 3u < b.size(); i += 4u) {
+            for (std::size_t c = 0; c < 3u; ++c) {
+                if (std::abs (static_cast<int>(a[i + c]) - static_cast<int>(b[i + c])) > tol) { ++nd; break; }
+            }
+        }
+        return nd;
+    }
+
+    //! Count the pixels of px that differ from the background colour
+    std::size_t count_foreground (const std::vector<std::uint8_t>& px) const
+    {
+        std::size_t nf = 0;
+        for (std::size_t i = 0; i + 3u < px.size(); i += 4u) {
+            for (std::size_t c = 0; c < 3u; ++c) {
+                if (std::abs (static_cast<int>(px[i + c]) - static_cast<int>(this->bgcolour[c] * 255.0f + 0.5f)) > 1) { ++nf; break; }
+            }
+        }
+        return nf;
+    }
+
+private:
+    bool create_context()
+    {
+        this->dpy = eglGetPlatformDisplay (EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (this->dpy == EGL_NO_DISPLAY) { std::cout << "No surfaceless EGL display\n"; return false; }
+        if (eglInitialize (this->dpy, nullptr, nullptr) == EGL_FALSE) {
+            std::cout << "Failed to eglInitialize\n";
+            this->dpy = EGL_NO_DISPLAY;
+            return false;
+        }
+        if (eglBindAPI (EGL_OPENGL_API) == EGL_FALSE) { std::cout << "Failed to eglBindAPI\n"; return false; }
+        static const EGLint attribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 1,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        // No surface will be created, so no config is needed (EGL_KHR_no_config_context)
+        this->ctx = eglCreateContext (this->dpy, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attribs);
+        if (this->ctx == EGL_NO_CONTEXT) { std::cout << "Failed to create an OpenGL 4.1 core context\n"; return false; }
+        if (eglMakeCurrent (this->dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, this->ctx) == EGL_FALSE) {
+            std::cout << "Failed to eglMakeCurrent\n";
+            return false;
+        }
+        return true;
+    }
+
+    static GLADapiproc get_proc_address (const char* name)
+    {
+        return reinterpret_cast<GLADapiproc>(eglGetProcAddress (name));
+    }
+
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    EGLContext ctx = EGL_NO_CONTEXT;
+    mplot::headless_surface surface;
+    GLuint fbo = 0;
+    GLuint rbo[2] = { 0, 0 };
+    bool initialised = false;
+    bool have_fbo = false;
+};
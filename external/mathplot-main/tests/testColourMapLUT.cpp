@@ -0,0 +1,146 @@
+/*
+ * Test the batch, lookup-table ColourMap::convert against the per-datum convert, and profile
+ * the two on a field of 200000 values (the size of a large HexGridVisual).
+ */
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <limits>
+
+#include <mplot/ColourMap.h>
+#include <sm/vvec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// The largest difference in any colour channel between rgb[3i..3i+2] and c
+float coldiff (const std::vector<float>& rgb, std::size_t i, const std::array<float, 3>& c)
+{
+    return std::max ({ std::abs (rgb[3 * i] - c[0]), std::abs (rgb[3 * i + 1] - c[1]), std::abs (rgb[3 * i + 2] - c[2]) });
+}
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr unsigned int n = 200000;
+    sm::vvec<float> data (n, 0.0f);
+    data.randomize();
+    // Out of range values are clamped, just as they are by convert(T)
+    data[0] = -0.5f;
+    data[1] = 1.5f;
+    data[2] = 0.0f;
+    data[3] = 1.0f;
+    data[4] = 1e-6f;
+
+    // Datums on the lookup table's sample points, which must convert exactly
+    constexpr unsigned int nl = mplot::ColourMap<float>::lut_size;
+    std::vector<float> grid (nl);
+    for (unsigned int i = 0; i < nl; ++i) { grid[i] = static_cast<float>(i) / static_cast<float>(nl - 1); }
+
+    std::vector<float> rgb;
+    sc::duration t_single_total = sc::duration::zero();
+    sc::duration t_batch_total = sc::duration::zero();
+    unsigned int n_maps = 0;
+
+    for (uint32_t ti = 0; ti < static_cast<uint32_t>(mplot::ColourMapType::N_entries); ++ti) {
+        mplot::ColourMapType cmt = static_cast<mplot::ColourMapType>(ti);
+        if (mplot::ColourMap<float>::numDatums (cmt) != 1) { continue; }
+        mplot::ColourMap<float> cm (cmt);
+        ++n_maps;
+
+        cm.convert (grid, rgb);
+        for (unsigned int i = 0; i < nl; ++i) {
+            if (coldiff (rgb, i, cm.convert (grid[i])) > 0.0f) {
+                std::cout << "Fail: " << cm.getTypeStr() << " LUT differs from convert at its sample point " << i << std::endl;
+                --rtn;
+                break;
+            }
+        }
+
+        sc::time_point t0 = sc::now();
+        cm.convert (data, rgb);
+        t_batch_total += sc::now() - t0;
+
+        std::vector<float> rgb_single (3 * n);
+        t0 = sc::now();
+        for (unsigned int i = 0; i < n; ++i) {
+            std::array<float, 3> c = cm.convert (data[i]);
+            rgb_single[3 * i] = c[0];
+            rgb_single[3 * i + 1] = c[1];
+            rgb_single[3 * i + 2] = c[2];
+        }
+        t_single_total += sc::now() - t0;
+
+        // Colours may differ where a datum lies between two LUT entries that straddle a step
+        // in the map, so count the large differences rather than requiring equality.
+        float maxdiff = 0.0f;
+        unsigned int n_large = 0;
+        for (unsigned int i = 0; i < n; ++i) {
+            std::array<float, 3> c = { rgb_single[3 * i], rgb_single[3 * i + 1], rgb_single[3 * i + 2] };
+            float d = coldiff (rgb, i, c);
+            maxdiff = std::max (maxdiff, d);
+            if (d > 0.05f) { ++n_large; }
+        }
+        // The clamped and end-point datums must match exactly. A tiny datum must not be given
+        // the colour of 0 (which some maps treat specially)
+        for (unsigned int i = 0; i < 5; ++i) {
+            if (coldiff (rgb, i, cm.convert (data[i])) > (i < 4 ? 0.0f : 0.01f)) {
+                std::cout << "Fail: " << cm.getTypeStr() << " differs for datum " << data[i] << std::endl;
+                --rtn;
+            }
+        }
+        if (n_large > n / 1000) {
+            std::cout << "Fail: " << cm.getTypeStr() << " has " << n_large << " colours that differ by > 0.05 (max "
+                      << maxdiff << ")\n";
+            --rtn;
+        }
+    }
+
+    // NaN converts to the map's NaN colour
+    mplot::ColourMap<float> cm_nan (mplot::ColourMapType::Jet);
+    std::vector<float> withnan = { 0.2f, std::numeric_limits<float>::quiet_NaN(), 0.8f };
+    cm_nan.convert (withnan, rgb);
+    if (coldiff (rgb, 1, mplot::ColourMap<float>::nanColour (mplot::ColourMapType::Jet)) > 0.0f) {
+        std::cout << "Fail: NaN colour\n";
+        --rtn;
+    }
+
+    // The LUT is re-baked when the map's parameters change
+    mplot::ColourMap<float> cm_hue (mplot::ColourMapType::Monochrome);
+    cm_hue.setHue (0.1f);
+    cm_hue.convert (withnan, rgb);
+    cm_hue.setHue (0.6f);
+    cm_hue.convert (withnan, rgb);
+    if (coldiff (rgb, 2, cm_hue.convert (0.8f)) > 0.0f) {
+        std::cout << "Fail: LUT was not re-baked after setHue\n";
+        --rtn;
+    }
+
+    // Integral data is scaled by range_max before lookup
+    mplot::ColourMap<unsigned char> cm_uc (mplot::ColourMapType::Viridis);
+    std::vector<unsigned char> ucdata (256);
+    for (unsigned int i = 0; i < 256; ++i) { ucdata[i] = static_cast<unsigned char>(i); }
+    cm_uc.convert (ucdata, rgb);
+    for (unsigned int i = 0; i < 256; ++i) {
+        if (coldiff (rgb, i, cm_uc.convert (ucdata[i])) > 0.01f) {
+            std::cout << "Fail: unsigned char datum " << i << std::endl;
+            --rtn;
+            break;
+        }
+    }
+
+    // 2D maps fall back to per-datum conversion
+    mplot::ColourMap<float> cm_2d (mplot::ColourMapType::HSV);
+    cm_2d.convert (withnan, rgb);
+    if (coldiff (rgb, 0, cm_2d.convert (0.2f)) > 0.0f) { std::cout << "Fail: 2D map\n"; --rtn; }
+
+    std::cout << n << " datums, mean over " << n_maps << " 1D colour maps:\n"
+              << "  convert (per datum): " << duration_cast<microseconds>(t_single_total).count() / n_maps << " us\n"
+              << "  convert (batch LUT): " << duration_cast<microseconds>(t_batch_total).count() / n_maps << " us\n";
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
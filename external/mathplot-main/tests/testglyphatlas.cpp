@@ -0,0 +1,124 @@
+/*
+ * Test the packing of GlyphAtlas: every glyph must lie inside the atlas, no two glyphs may
+ * overlap and each glyph's pixels must survive the atlas growing.
+ */
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+
+#include <mplot/GlyphAtlas.h>
+#include <sm/random>
+#include <sm/vec>
+
+// A pixel value for row r, column c of glyph g. Never 0, which is the value of empty atlas pixels.
+unsigned char pixval (int g, int r, int c) { return static_cast<unsigned char>((g * 31 + r * 7 + c) % 251 + 1); }
+
+int main()
+{
+    int rtn = 0;
+
+    // Start small, so that the atlas has to grow many times
+    mplot::visgl::GlyphAtlas atlas (64, 64);
+    sm::rand_uniform<int> rng_w (1, 40, 2468);
+    sm::rand_uniform<int> rng_h (1, 50, 1357);
+
+    constexpr int ng = 3000;
+    std::vector<sm::vec<int, 4>> rects (ng);
+    for (int g = 0; g < ng; ++g) {
+        const int w = rng_w.get();
+        const int h = rng_h.get();
+        // Rows are pitch bytes apart, as in a FreeType bitmap, with unused bytes on the end
+        const int pitch = w + 3;
+        std::vector<unsigned char> bitmap (static_cast<std::size_t>(pitch) * h, 0xff);
+        for (int r = 0; r < h; ++r) {
+            for (int c = 0; c < w; ++c) { bitmap[r * pitch + c] = pixval (g, r, c); }
+        }
+        rects[g] = atlas.add (w, h, bitmap.data(), pitch);
+        if (rects[g][2] != w || rects[g][3] != h) {
+            std::cout << "Fail: glyph " << g << " has the wrong size in the atlas\n";
+            --rtn;
+        }
+    }
+
+    const int aw = atlas.width();
+    const int ah = atlas.height();
+    const std::vector<unsigned char>& pix = atlas.pixels();
+    if (pix.size() != static_cast<std::size_t>(aw) * ah) { std::cout << "Fail: pixels size\n"; --rtn; }
+
+    // Mark the atlas pixels that each glyph covers. A pixel covered twice is an overlap.
+    std::vector<int> owner (static_cast<std::size_t>(aw) * ah, -1);
+    int n_outside = 0;
+    int n_overlap = 0;
+    int n_wrong = 0;
+    for (int g = 0; g < ng; ++g) {
+        const sm::vec<int, 4>& rc = rects[g];
+        if (rc[0] < 0 || rc[1] < 0 || rc[0] + rc[2] > aw || rc[1] + rc[3] > ah) { ++n_outside; continue; }
+        for (int r = 0; r < rc[3]; ++r) {
+            for (int c = 0; c < rc[2]; ++c) {
+                const std::size_t i = static_cast<std::size_t>(rc[1] + r) * aw + rc[0] + c;
+                if (owner[i] != -1) { ++n_overlap; }
+                owner[i] = g;
+                if (pix[i] != pixval (g, r, c)) { ++n_wrong; }
+            }
+        }
+    }
+    // The padding around each glyph must be empty, so that linear filtering does not pick up
+    // pixels from a neighbouring glyph
+    int n_unpadded = 0;
+    for (std::size_t i = 0; i < owner.size(); ++i) { if (owner[i] == -1 && pix[i] != 0) { ++n_unpadded; } }
+    for (int y = 0; y < ah; ++y) {
+        for (int x = 0; x + 1 < aw; ++x) {
+            const int a = owner[static_cast<std::size_t>(y) * aw + x];
+            const int b = owner[static_cast<std::size_t>(y) * aw + x + 1];
+            if (a != -1 && b != -1 && a != b) { ++n_unpadded; }
+        }
+    }
+
+    if (n_outside > 0) { std::cout << "Fail: " << n_outside << " glyphs lie outside the atlas\n"; --rtn; }
+    if (n_overlap > 0) { std::cout << "Fail: " << n_overlap << " pixels are covered by more than one glyph\n"; --rtn; }
+    if (n_wrong > 0) { std::cout << "Fail: " << n_wrong << " glyph pixels were not preserved\n"; --rtn; }
+    if (n_unpadded > 0) { std::cout << "Fail: " << n_unpadded << " pixels break the padding between glyphs\n"; --rtn; }
+
+    // The atlas grew, so all of it needs to be uploaded
+    if (atlas.generation() == 0) { std::cout << "Fail: the atlas did not grow\n"; --rtn; }
+    if (!atlas.dirty() || atlas.dirty_rows()[0] != 0 || atlas.dirty_rows()[1] != ah) {
+        std::cout << "Fail: after growth, the whole atlas should be dirty\n";
+        --rtn;
+    }
+
+    // Adding a glyph without growth dirties only its rows
+    atlas.clear_dirty();
+    if (atlas.dirty()) { std::cout << "Fail: clear_dirty\n"; --rtn; }
+    const unsigned int gen = atlas.generation();
+    unsigned char dot = 255;
+    sm::vec<int, 4> drc = atlas.add (1, 1, &dot, 1);
+    if (atlas.generation() == gen) {
+        if (atlas.dirty_rows()[0] != drc[1] || atlas.dirty_rows()[1] != drc[1] + 1) {
+            std::cout << "Fail: dirty rows " << atlas.dirty_rows() << " for a glyph at row " << drc[1] << std::endl;
+            --rtn;
+        }
+    }
+
+    // Empty glyphs (spaces) take no room
+    const float occ = atlas.occupancy();
+    if (atlas.add (0, 0, nullptr, 0) != sm::vec<int, 4>{ 0, 0, 0, 0 } || atlas.occupancy() != occ) {
+        std::cout << "Fail: empty glyph\n";
+        --rtn;
+    }
+    if (occ <= 0.0f || occ > 1.0f) { std::cout << "Fail: occupancy " << occ << std::endl; --rtn; }
+
+    // A glyph can't be bigger than the largest atlas
+    bool threw = false;
+    try {
+        atlas.add (mplot::visgl::GlyphAtlas::max_size, 1, nullptr, 0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) { std::cout << "Fail: oversized glyph did not throw\n"; --rtn; }
+
+    std::cout << ng << " glyphs packed into a " << aw << "x" << ah << " atlas after "
+              << atlas.generation() << " doublings; occupancy " << occ << std::endl;
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,257 @@
+/*
+ * Test min/max decimation in mplot::graphing, then stream 1000000 data points into real
+ * GraphVisuals (in a headless, surfaceless EGL context, rendering into a framebuffer object):
+ *
+ * 'Full rebuild': the original behaviour, without setstreaming(). Every append re-scales all
+ * the data into model coordinates and regenerates every vertex.
+ *
+ * 'Streaming': GraphVisual::setstreaming(), with and without decimation. Data are held in a
+ * sliding window, decimated incrementally and vertices are generated only for the new line
+ * segments. render() uploads only those vertices (reinit_buffers_tail).
+ *
+ * At the end of each stream, the GL buffers are read back and compared with the CPU-side
+ * vertices, and the vertex and decimated coordinate counts and the pixels are compared with
+ * those of a full rebuild of the same graph. If no headless context can be created, the
+ * GraphVisual tests are skipped (exit code 77).
+ */
+#include "headless_visual.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <memory>
+
+#include <sm/vec>
+#include <sm/vvec>
+#include <mplot/graphing.h>
+#include <mplot/GraphVisual.h>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// Expose the vertices, decimated coordinates and GL buffers of a GraphVisual
+struct graph_probe : public mplot::GraphVisual<float>
+{
+    graph_probe (const sm::vec<float> offset) : mplot::GraphVisual<float> (offset) {}
+
+    std::size_t num_vertices() const { return this->vertexPositions.size() / 3u; }
+    std::size_t num_decimated() const { return this->decimatedCoords.empty() ? 0u : this->decimatedCoords[0].size(); }
+    std::size_t num_data() const { return this->graphDataCoords.empty() ? 0u : this->graphDataCoords[0]->size(); }
+    std::size_t vertex_capacity() const { return this->vbo_capacity[this->posnVBO]; }
+
+    // Compare each GL buffer with its CPU-side array. Return the number of buffers that differ.
+    int compare_buffers (headless_visual& v)
+    {
+        int bad = 0;
+        auto check = [&bad](const auto& gpu, const auto& cpu, const char* what)
+        {
+            if (gpu != cpu) { std::cout << "  GL " << what << " buffer differs from the CPU-side data\n"; ++bad; }
+        };
+        check (v.read_buffer<GLuint> (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO], this->indices.size()), this->indices, "index");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->posnVBO], this->vertexPositions.size()), this->vertexPositions, "position");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->normVBO], this->vertexNormals.size()), this->vertexNormals, "normal");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->colVBO], this->vertexColors.size()), this->vertexColors, "colour");
+        return bad;
+    }
+
+    // Rebuild all the vertices from the data currently held, and upload them
+    void rebuild()
+    {
+        mplot::VisualModel<mplot::gl::version_4_1>::clear();
+        this->initializeVertices();
+        this->reinit_buffers();
+    }
+};
+
+// The signal to stream: noisy and rapidly varying
+float signal (const std::size_t i) { return 0.9f * std::sin (static_cast<float>(i) * 4e-5f) * std::cos (static_cast<float>(i) * 0.37f); }
+
+// Make a GraphVisual for n data points, streaming if window > 0
+std::unique_ptr<graph_probe> make_graph (headless_visual& v, const std::size_t n, const std::size_t window, const unsigned int columns)
+{
+    auto gv = std::make_unique<graph_probe> (sm::vec<float>{ -0.6f, -0.5f, 0.0f });
+    v.bindmodel (gv);
+    gv->setsize (1.2f, 1.0f);
+    gv->setlimits (0.0f, static_cast<float>(n), -1.0f, 1.0f);
+    mplot::DatasetStyle ds (mplot::stylepolicy::lines);
+    gv->prepdata (ds);
+    if (window > 0u) { gv->setstreaming (window, columns); }
+    gv->finalize();
+    return gv;
+}
+
+// Stream n appends into a streaming graph, rendering every render_every appends, then check it
+// against a full rebuild. Return 0 on success.
+int stream (headless_visual& v, const std::size_t n, const std::size_t window, const unsigned int columns,
+            const std::size_t render_every, const double us_full)
+{
+    int rtn = 0;
+    auto gv = make_graph (v, n, window, columns);
+    graph_probe* gp = v.addVisualModel (gv);
+
+    unsigned int vertex_reallocs = 0;
+    unsigned int window_moves = 0;
+    unsigned int renders = 0;
+    std::size_t ndata = 0;
+    std::size_t vcap = gp->vertex_capacity();
+    sc::duration t_append = sc::duration::zero();
+    sc::duration t_render = sc::duration::zero();
+    for (std::size_t i = 0; i < n; i += render_every) {
+        sc::time_point t0 = sc::now();
+        for (std::size_t j = i; j < i + render_every && j < n; ++j) { gp->append (static_cast<float>(j), signal (j), 0); }
+        sc::time_point t1 = sc::now();
+        v.render();
+        t_append += t1 - t0;
+        t_render += sc::now() - t1;
+        ++renders;
+        if (gp->num_data() < ndata) { ++window_moves; }
+        ndata = gp->num_data();
+        if (gp->vertex_capacity() != vcap) { ++vertex_reallocs; vcap = gp->vertex_capacity(); }
+    }
+    const double us_stream = duration_cast<nanoseconds>(t_append).count() / 1000.0 / n;
+    const double ms_render = duration_cast<microseconds>(t_render).count() / 1000.0 / renders;
+
+    std::cout << "Streaming (window " << window << ", " << columns << " columns): " << us_stream
+              << " us per append, averaged over " << n << " appends (x" << (us_stream > 0.0 ? us_full / us_stream : 0.0)
+              << " faster than full rebuild); " << ms_render << " ms per render (every " << render_every << " appends)\n";
+    std::cout << "  " << gp->num_data() << " data points, " << gp->num_decimated() << " decimated points, "
+              << gp->num_vertices() << " vertices, " << vertex_reallocs << " vertex buffer re-allocations in "
+              << renders << " renders; the window moved " << window_moves << " times\n";
+
+    // The window holds between window and 2 * window data points
+    if (gp->num_data() < window || gp->num_data() >= 2u * window) { std::cout << "  Fail: window holds " << gp->num_data() << " points\n"; --rtn; }
+    if (columns > 0u && (gp->num_decimated() == 0u || gp->num_decimated() > 2u * columns)) {
+        std::cout << "  Fail: " << gp->num_decimated() << " decimated points for " << columns << " columns\n";
+        --rtn;
+    }
+    // Moving the window uploads all the vertices into buffers of exactly the right size, which
+    // the next append then grows. Otherwise the buffers are grown geometrically, so they are
+    // re-allocated only a few times as they first fill, not on every render.
+    if (vertex_reallocs > 2u * window_moves + 20u) { std::cout << "  Fail: the vertex buffers were re-allocated too often\n"; --rtn; }
+
+    // Uploading only the tail of the vertices must have left the GL buffers equal to the CPU-side arrays
+    if (gp->compare_buffers (v) != 0) { --rtn; }
+    const std::vector<std::uint8_t> px_stream = v.pixels();
+
+    // A full rebuild from the same data gives the same vertices and decimated coordinates
+    const std::size_t nv_stream = gp->num_vertices();
+    const std::size_t nd_stream = gp->num_decimated();
+    gp->rebuild();
+    if (gp->num_vertices() != nv_stream || gp->num_decimated() != nd_stream) {
+        std::cout << "  Fail: full rebuild gave " << gp->num_vertices() << " vertices and " << gp->num_decimated()
+                  << " decimated points, not " << nv_stream << " and " << nd_stream << std::endl;
+        --rtn;
+    }
+    if (gp->compare_buffers (v) != 0) { --rtn; }
+    v.render();
+    const std::vector<std::uint8_t> px_rebuilt = v.pixels();
+    const std::size_t fg = v.count_foreground (px_stream);
+    const std::size_t nd = headless_visual::count_differences (px_stream, px_rebuilt);
+    std::cout << "  Pixels: " << fg << " foreground, " << nd << " differ from the full rebuild\n";
+    if (fg < 1000u || nd != 0u) { std::cout << "  Fail: streamed and rebuilt graphs look different\n"; --rtn; }
+
+    v.removeVisualModel (gp);
+    return rtn;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr float width = 1.0f;
+    constexpr unsigned int ncols = 500;
+
+    // A noisy, rapidly varying signal across the width of the graph
+    constexpr std::size_t n = 1000000;
+    std::vector<sm::vec<float>> coords (n);
+    float ymin = std::numeric_limits<float>::max();
+    float ymax = std::numeric_limits<float>::lowest();
+    for (std::size_t i = 0; i < n; ++i) {
+        float x = width * static_cast<float>(i) / static_cast<float>(n);
+        float y = 0.5f + 0.4f * std::sin (x * 40.0f) * std::cos (static_cast<float>(i) * 0.37f);
+        coords[i] = { x, y, 0.0f };
+        ymin = std::min (ymin, y);
+        ymax = std::max (ymax, y);
+    }
+
+    // Decimate in one pass
+    std::vector<sm::vec<float>> dec;
+    std::size_t consumed = mplot::graphing::decimate_minmax (coords, 0, n, width, ncols, true, dec);
+    std::cout << n << " points decimated to " << dec.size() << " for " << ncols << " columns\n";
+    if (consumed != n) { std::cout << "Fail: not all points consumed\n"; --rtn; }
+    if (dec.size() > 2 * ncols) { std::cout << "Fail: too many decimated points\n"; --rtn; }
+    float dmin = std::numeric_limits<float>::max();
+    float dmax = std::numeric_limits<float>::lowest();
+    for (auto d : dec) { dmin = std::min (dmin, d[1]); dmax = std::max (dmax, d[1]); }
+    if (dmin != ymin || dmax != ymax) { std::cout << "Fail: decimation lost the extrema\n"; --rtn; }
+    for (std::size_t i = 1; i < dec.size(); ++i) {
+        if (dec[i][0] < dec[i - 1][0]) { std::cout << "Fail: decimated points out of order\n"; --rtn; break; }
+    }
+
+    // Decimating incrementally (as GraphVisual does when data are appended) must give the same result
+    std::vector<sm::vec<float>> dec_inc;
+    std::size_t done = 0;
+    for (std::size_t end = 1000; end <= n; end += 1000) {
+        done = mplot::graphing::decimate_minmax (coords, done, end, width, ncols, false, dec_inc);
+    }
+    mplot::graphing::decimate_minmax (coords, done, n, width, ncols, true, dec_inc);
+    if (dec_inc.size() != dec.size()) {
+        std::cout << "Fail: incremental decimation gave " << dec_inc.size() << " points, not " << dec.size() << std::endl;
+        --rtn;
+    } else {
+        for (std::size_t i = 0; i < dec.size(); ++i) {
+            if (dec_inc[i] != dec[i]) { std::cout << "Fail: incremental decimation differs at " << i << std::endl; --rtn; break; }
+        }
+    }
+
+    // A sparse series (fewer points than columns) is passed through unchanged
+    std::vector<sm::vec<float>> sparse = { {0.1f, 0.2f, 0.0f}, {0.5f, 0.9f, 0.0f}, {0.9f, 0.1f, 0.0f} };
+    std::vector<sm::vec<float>> dec_sparse;
+    mplot::graphing::decimate_minmax (sparse, 0, sparse.size(), width, ncols, true, dec_sparse);
+    if (dec_sparse != sparse) { std::cout << "Fail: sparse series was changed by decimation\n"; --rtn; }
+
+    /*
+     * Stream data into GraphVisuals
+     */
+    constexpr int w = 320;
+    constexpr int h = 240;
+    headless_visual v (w, h);
+    if (!v.ready()) {
+        std::cout << "No headless OpenGL 4.1 context is available; skipping the GraphVisual tests\n";
+        std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+        return rtn == 0 ? 77 : rtn;
+    }
+    v.showCoordArrows (false);
+    v.setSceneTrans (sm::vec<float, 3>{ 0.0f, 0.0f, -2.2f });
+
+    constexpr std::size_t render_every = 1000;
+
+    // The full rebuild is O(n) per append, so only time the first part of the series
+    double us_full = 0.0;
+    {
+        constexpr std::size_t n_full = 5000;
+        auto gv = make_graph (v, n_full, 0u, 0u);
+        graph_probe* gp = v.addVisualModel (gv);
+        sc::duration t_append = sc::duration::zero();
+        for (std::size_t i = 0; i < n_full; i += render_every) {
+            sc::time_point t0 = sc::now();
+            for (std::size_t j = i; j < i + render_every; ++j) { gp->append (static_cast<float>(j), signal (j), 0); }
+            t_append += sc::now() - t0;
+            v.render();
+        }
+        us_full = duration_cast<nanoseconds>(t_append).count() / 1000.0 / n_full;
+        std::cout << "Full rebuild: " << us_full << " us per append, averaged over the first "
+                  << n_full << " appends (and growing linearly with data size)\n";
+        v.removeVisualModel (gp);
+    }
+
+    // Decimated into as many columns as the graph is wide on screen. Without decimation, every
+    // segment is drawn, so a smaller window keeps the (software) rendering time down. Neither
+    // window divides n, so that the stream ends some way after the window last moved.
+    rtn += stream (v, n, 80000u, static_cast<unsigned int>(w), render_every, us_full);
+    rtn += stream (v, n, 6000u, 0u, render_every, us_full);
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
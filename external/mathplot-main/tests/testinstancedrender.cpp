@@ -0,0 +1,232 @@
+/*
+ * Render instanced markers with a headless (surfaceless EGL) OpenGL context into a framebuffer
+ * object and compare the pixels with those of the original one-mesh-per-marker rendering:
+ *
+ * ScatterVisual with and without instanced_markers, also after reinit_instances().
+ *
+ * GraphVisual with and without instanced_markers.
+ *
+ * A streaming GraphVisual with instanced_markers, whose vertices and instances are uploaded
+ * incrementally (reinit_buffers_tail and reinit_instance_buffers_tail). The GL buffers are read
+ * back and compared with the CPU-side arrays, the growth of the buffers is checked to be
+ * geometric, and the pixels are compared with those rendered after a full upload.
+ *
+ * Built with HEADLESS_NOMX defined, the same tests run on the non-multicontext code. If no
+ * headless context can be created, the test is skipped (exit code 77).
+ */
+#include "headless_visual.h"
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <memory>
+
+#include <mplot/ScatterVisual.h>
+#include <mplot/GraphVisual.h>
+#include <sm/vec>
+#include <sm/vvec>
+
+// Expose the GL buffers of a streaming GraphVisual
+struct graph_probe : public mplot::GraphVisual<float>
+{
+    graph_probe (const sm::vec<float> offset) : mplot::GraphVisual<float> (offset) {}
+
+    const instanced_mesh& markers() const { return this->instmeshes[0]; }
+    std::size_t vertex_capacity() const { return this->vbo_capacity[this->posnVBO]; }
+
+    // Compare each GL buffer with its CPU-side array. Return the number of buffers that differ.
+    int compare_buffers (headless_visual& v)
+    {
+        int bad = 0;
+        auto check = [&bad](const auto& gpu, const auto& cpu, const char* what)
+        {
+            if (gpu != cpu) { std::cout << "  GL " << what << " buffer differs from the CPU-side data\n"; ++bad; }
+        };
+        check (v.read_buffer<GLuint> (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO], this->indices.size()), this->indices, "index");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->posnVBO], this->vertexPositions.size()), this->vertexPositions, "position");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->normVBO], this->vertexNormals.size()), this->vertexNormals, "normal");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, this->vbos[this->colVBO], this->vertexColors.size()), this->vertexColors, "colour");
+        const auto& im = this->markers();
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, im.vbos[this->instOffsVBO], im.instancePositions.size()), im.instancePositions, "instance position");
+        check (v.read_buffer<float> (GL_ARRAY_BUFFER, im.vbos[this->instColVBO], im.instanceColors.size()), im.instanceColors, "instance colour");
+        // The buffers must be as large as their recorded capacity
+        if (v.buffer_size (GL_ARRAY_BUFFER, im.vbos[this->instOffsVBO]) != static_cast<GLint>(im.instance_capacity * 4u * sizeof(float))) {
+            std::cout << "  Instance buffer size does not match instance_capacity\n";
+            ++bad;
+        }
+        return bad;
+    }
+
+    // Upload all the vertices and instances, as a non-streaming graph would
+    void full_upload()
+    {
+        this->reinit_buffers();
+        this->reinit_instance_buffers();
+    }
+};
+
+// Render the scene containing only the model mp and return the pixels
+template <typename T>
+std::vector<std::uint8_t> render_alone (headless_visual& v, std::unique_ptr<T>& mp)
+{
+    T* p = v.addVisualModel (mp);
+    v.render();
+    std::vector<std::uint8_t> px = v.pixels();
+    v.removeVisualModel (p);
+    return px;
+}
+
+// Compare pixels a and b (where there are at least min_fg foreground pixels in a). Allow up to
+// max_frac of the foreground pixels to differ by more than tol, to allow for the rounding
+// differences between the shader's and the CPU's vertex arithmetic.
+int compare_pixels (const headless_visual& v, const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b,
+                    const char* what, const std::size_t min_fg, const double max_frac, const int tol)
+{
+    const std::size_t fg = v.count_foreground (a);
+    const std::size_t nd = headless_visual::count_differences (a, b, tol);
+    std::cout << what << ": " << fg << " foreground pixels, " << nd << " differ\n";
+    if (fg < min_fg) { std::cout << "  Fail: too little was drawn\n"; return 1; }
+    if (static_cast<double>(nd) > max_frac * static_cast<double>(fg)) { std::cout << "  Fail: too many pixels differ\n"; return 1; }
+    return 0;
+}
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr int w = 320;
+    constexpr int h = 240;
+    headless_visual v (w, h);
+    if (!v.ready()) {
+        std::cout << "No headless OpenGL 4.1 context is available; skipping\n";
+        return 77;
+    }
+    v.showCoordArrows (false);
+    v.lightingEffects();
+
+    // ScatterVisual
+    {
+        constexpr unsigned int n = 300;
+        std::vector<sm::vec<float>> coords (n);
+        sm::vvec<float> data (n, 0.0f);
+        data.randomize();
+        sm::vvec<float> r (3u * n, 0.0f);
+        r.randomize (-0.8f, 0.8f);
+        for (unsigned int i = 0; i < n; ++i) { coords[i] = { r[3 * i], r[3 * i + 1], r[3 * i + 2] }; }
+
+        auto make_scatter = [&v, &coords, &data](const bool instanced)
+        {
+            auto sv = std::make_unique<mplot::ScatterVisual<float>> (sm::vec<float>{});
+            v.bindmodel (sv);
+            sv->instanced_markers = instanced;
+            sv->radiusFixed = 0.03f;
+            sv->setDataCoords (&coords);
+            sv->setScalarData (&data);
+            sv->finalize();
+            return sv;
+        };
+
+        auto sv_mesh = make_scatter (false);
+        auto sv_inst = make_scatter (true);
+        auto px_mesh = render_alone (v, sv_mesh);
+        auto px_inst = render_alone (v, sv_inst);
+        rtn -= compare_pixels (v, px_mesh, px_inst, "ScatterVisual, instanced vs one mesh per marker", 2000u, 0.01, 8);
+
+        // Build from different data, then change the data back and update only the instances
+        const std::vector<sm::vec<float>> coords0 = coords;
+        const sm::vvec<float> data0 = data;
+        for (auto& c : coords) { c *= 0.7f; }
+        data = 1.0f - data;
+        sv_inst = make_scatter (true);
+        mplot::ScatterVisual<float>* svp = v.addVisualModel (sv_inst);
+        coords = coords0;
+        data = data0;
+        svp->reinit_instances();
+        v.render();
+        px_inst = v.pixels();
+        v.removeVisualModel (svp);
+        rtn -= compare_pixels (v, px_mesh, px_inst, "ScatterVisual, after reinit_instances()", 2000u, 0.01, 8);
+    }
+
+    // Move closer to the graphs
+    v.setSceneTrans (sm::vec<float, 3>{ 0.0f, 0.0f, -2.2f });
+
+    // GraphVisual
+    {
+        sm::vvec<float> x;
+        x.linspace (0.0f, 1.0f, 60);
+        sm::vvec<float> y = (x * 6.0f).sin();
+
+        auto make_graph = [&v, &x, &y](const bool instanced)
+        {
+            auto gv = std::make_unique<mplot::GraphVisual<float>> (sm::vec<float>{ -0.6f, -0.5f, 0.0f });
+            v.bindmodel (gv);
+            gv->instanced_markers = instanced;
+            gv->setsize (1.2f, 1.0f);
+            gv->setlimits (0.0f, 1.0f, -1.2f, 1.2f);
+            mplot::DatasetStyle ds (mplot::stylepolicy::markers);
+            ds.markerstyle = mplot::markerstyle::uphexagon;
+            ds.markersize = 0.04f;
+            gv->setdata (x, y, ds);
+            gv->finalize();
+            return gv;
+        };
+
+        auto gv_mesh = make_graph (false);
+        auto gv_inst = make_graph (true);
+        auto px_mesh = render_alone (v, gv_mesh);
+        auto px_inst = render_alone (v, gv_inst);
+        rtn -= compare_pixels (v, px_mesh, px_inst, "GraphVisual, instanced vs one mesh per marker", 2000u, 0.01, 8);
+    }
+
+    // Streaming GraphVisual, with instanced markers and lines
+    {
+        auto gv = std::make_unique<graph_probe> (sm::vec<float>{ -0.6f, -0.5f, 0.0f });
+        v.bindmodel (gv);
+        gv->instanced_markers = true;
+        gv->setsize (1.2f, 1.0f);
+        gv->setlimits (0.0f, 1.0f, -1.2f, 1.2f);
+        mplot::DatasetStyle ds (mplot::stylepolicy::both);
+        ds.markersize = 0.01f;
+        ds.markergap = 0.0f; // so that every line segment is drawn
+        gv->prepdata (ds);
+        gv->setstreaming (100000u);
+        gv->finalize();
+        graph_probe* gp = v.addVisualModel (gv);
+
+        constexpr unsigned int frames = 100;
+        constexpr unsigned int per_frame = 40;
+        unsigned int instance_reallocs = 0;
+        unsigned int vertex_reallocs = 0;
+        std::size_t icap = gp->markers().instance_capacity;
+        std::size_t vcap = gp->vertex_capacity();
+        for (unsigned int f = 0; f < frames; ++f) {
+            for (unsigned int i = 0; i < per_frame; ++i) {
+                const float t = static_cast<float>(f * per_frame + i) / static_cast<float>(frames * per_frame);
+                gp->append (t, std::sin (t * 25.0f), 0);
+            }
+            v.render();
+            if (gp->markers().instance_capacity != icap) { ++instance_reallocs; icap = gp->markers().instance_capacity; }
+            if (gp->vertex_capacity() != vcap) { ++vertex_reallocs; vcap = gp->vertex_capacity(); }
+        }
+        const std::size_t ninst = gp->markers().num_instances();
+        std::cout << "Streaming GraphVisual: " << ninst << " marker instances in " << frames << " frames; "
+                  << instance_reallocs << " instance and " << vertex_reallocs << " vertex buffer re-allocations\n";
+        if (ninst != frames * per_frame) { std::cout << "  Fail: expected " << frames * per_frame << " instances\n"; --rtn; }
+        // Growing by doubling needs about log2(frames) re-allocations, rather than one per frame
+        if (instance_reallocs > 10u || vertex_reallocs > 10u) { std::cout << "  Fail: buffers are not grown geometrically\n"; --rtn; }
+
+        if (gp->compare_buffers (v) != 0) { --rtn; }
+        const std::vector<std::uint8_t> px_stream = v.pixels();
+
+        // Upload everything afresh and render again. The pixels must be identical.
+        gp->full_upload();
+        if (gp->compare_buffers (v) != 0) { --rtn; }
+        v.render();
+        rtn -= compare_pixels (v, px_stream, v.pixels(), "Streaming GraphVisual, incremental vs full upload", 1000u, 0.0, 0);
+        v.removeVisualModel (gp);
+    }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
@@ -0,0 +1,205 @@
+/*
+ * Profile the start-up of a scene of many VisualModels, building their vertices one after the
+ * other (as Visual::addVisualModel does) and on a pool of worker threads (as
+ * Visual::addVisualModelAsync does). The models built on the workers must be identical to those
+ * built serially.
+ *
+ * Also lay out texts on several threads at once with one shared font face, which loads new glyphs
+ * into its atlas as they are needed.
+ *
+ * No GL context or window is needed.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <algorithm>
+
+#include <mplot/VisualMX.h>
+#include <mplot/ScatterVisual.h>
+#include <mplot/VisualTextModelBase.h>
+#include <mplot/VisualFaceBase.h>
+#include <mplot/WorkerPool.h>
+#include <sm/vec>
+#include <sm/vvec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// Expose the vertex arrays of a ScatterVisual
+struct scatter_probe : public mplot::ScatterVisual<float>
+{
+    scatter_probe() : mplot::ScatterVisual<float> (sm::vec<float>{}) {}
+
+    bool same_vertices (const scatter_probe& other) const
+    {
+        return this->vertexPositions == other.vertexPositions && this->vertexNormals == other.vertexNormals
+        && this->vertexColors == other.vertexColors && this->indices == other.indices;
+    }
+    std::size_t num_vertices() const { return this->vertexPositions.size() / 3u; }
+};
+
+// A VisualFace without the GL texture
+struct face_probe : public mplot::visgl::VisualFaceBase
+{
+    face_probe (const mplot::VisualFont font, unsigned int fontpixels, FT_Library& ft)
+    {
+        this->init_common (font, fontpixels, ft);
+        this->load_ascii();
+    }
+};
+
+// A VisualTextModel without the GL buffers
+struct text_probe : public mplot::VisualTextModelBase<>
+{
+    text_probe (const mplot::TextFeatures& tf) : mplot::VisualTextModelBase<> (tf) {}
+
+    void render() final {}
+    mplot::TextGeometry getTextGeometry (const std::string&) final { return {}; }
+    mplot::TextGeometry getTextGeometry() final { return {}; }
+
+    void setup (const std::string& s, face_probe* f)
+    {
+        this->txt = mplot::unicode::fromUtf8 (s);
+        f->glyphs (this->txt);
+        this->layoutText (f);
+    }
+
+    const std::vector<float>& positions() const { return this->vertexPositions; }
+    const std::vector<float>& texcoords() const { return this->vertexTextures; }
+
+protected:
+    void postVertexInit() final {}
+    void setupVBO (GLuint&, std::vector<float>&, unsigned int) final {}
+};
+
+// A label for text i, with some characters that are outside printable ASCII
+std::string label (unsigned int i)
+{
+    static const std::vector<std::string> greek = { "α", "β", "γ", "δ", "ε", "ζ", "η", "θ", "λ", "μ", "π", "σ", "φ", "ω" };
+    return greek[i % greek.size()] + " = " + std::to_string (static_cast<float>(i) * 0.25f) + " " + greek[(i / 7) % greek.size()];
+}
+
+int main()
+{
+    int rtn = 0;
+
+    // A scene of nm scatter plots of np spheres each
+    constexpr unsigned int nm = 16;
+    constexpr unsigned int np = 1000;
+    std::vector<std::vector<sm::vec<float>>> coords (nm);
+    std::vector<sm::vvec<float>> data (nm);
+    for (unsigned int m = 0; m < nm; ++m) {
+        sm::vvec<float> r (3u * np, 0.0f);
+        r.randomize();
+        coords[m].resize (np);
+        for (unsigned int i = 0; i < np; ++i) { coords[m][i] = { r[3 * i], r[3 * i + 1], r[3 * i + 2] }; }
+        data[m].resize (np);
+        data[m].randomize();
+    }
+    auto make_models = [&coords, &data]()
+    {
+        std::vector<std::unique_ptr<scatter_probe>> models;
+        for (unsigned int m = 0; m < nm; ++m) {
+            models.push_back (std::make_unique<scatter_probe>());
+            models.back()->sizeFactor = 0.01f;
+            models.back()->setDataCoords (&coords[m]);
+            models.back()->setScalarData (&data[m]);
+        }
+        return models;
+    };
+
+    // Serial
+    std::vector<std::unique_ptr<scatter_probe>> serial = make_models();
+    sc::time_point t0 = sc::now();
+    for (auto& m : serial) { m->finalize(); }
+    sc::duration t_serial = sc::now() - t0;
+
+    // On the workers
+    std::vector<std::unique_ptr<scatter_probe>> parallel = make_models();
+    mplot::visgl::worker_pool pool;
+    t0 = sc::now();
+    std::vector<std::future<void>> built;
+    for (auto& m : parallel) {
+        scatter_probe* mp = m.get();
+        built.push_back (pool.submit ([mp]() { mp->finalize(); }));
+    }
+    for (auto& b : built) { b.get(); }
+    sc::duration t_parallel = sc::now() - t0;
+
+    for (unsigned int m = 0; m < nm; ++m) {
+        if (!parallel[m]->same_vertices (*serial[m])) {
+            std::cout << "Fail: model " << m << " built on a worker differs from the serially built model\n";
+            --rtn;
+        }
+    }
+
+    // Workers are marked as model-building threads (on which Visual's context callbacks do nothing)
+    if (mplot::visgl::model_build_thread) { std::cout << "Fail: the main thread is marked as a model-building thread\n"; --rtn; }
+    bool marked = true;
+    try {
+        pool.submit ([]() { if (!mplot::visgl::model_build_thread) { throw std::runtime_error ("not marked"); } }).get();
+    } catch (const std::runtime_error&) {
+        marked = false;
+    }
+    if (!marked) { std::cout << "Fail: a worker is not marked as a model-building thread\n"; --rtn; }
+
+    std::cout << nm << " models of " << np << " spheres (" << serial[0]->num_vertices() << " vertices each):\n"
+              << "  serial:  " << duration_cast<milliseconds>(t_serial).count() << " ms\n"
+              << "  " << pool.size() << " workers: " << duration_cast<milliseconds>(t_parallel).count() << " ms\n";
+
+    // Texts laid out on the workers with one face, in which glyphs are loaded on demand
+    FT_Library ft;
+    if (FT_Init_FreeType (&ft)) { std::cout << "Could not init FreeType\nFAIL\n"; return -1; }
+    {
+        mplot::TextFeatures tf (0.05f, 48, false, mplot::colour::black, mplot::VisualFont::DVSans);
+        constexpr unsigned int nt = 4000;
+
+        face_probe f_serial (tf.font, tf.fontres, ft);
+        std::vector<std::unique_ptr<text_probe>> t_ser;
+        for (unsigned int i = 0; i < nt; ++i) {
+            t_ser.push_back (std::make_unique<text_probe> (tf));
+            t_ser.back()->setup (label (i), &f_serial);
+        }
+
+        face_probe f_shared (tf.font, tf.fontres, ft);
+        std::vector<std::unique_ptr<text_probe>> t_par;
+        for (unsigned int i = 0; i < nt; ++i) { t_par.push_back (std::make_unique<text_probe> (tf)); }
+        // At least 4 threads, so that glyphs are loaded concurrently even on a small machine
+        mplot::visgl::worker_pool text_pool (std::max (4u, pool.size()));
+        constexpr unsigned int chunk = 250;
+        std::vector<std::future<void>> laid_out;
+        for (unsigned int c = 0; c < nt; c += chunk) {
+            laid_out.push_back (text_pool.submit ([&t_par, &f_shared, c]() {
+                for (unsigned int i = c; i < c + chunk; ++i) { t_par[i]->setup (label (i), &f_shared); }
+            }));
+        }
+        for (auto& l : laid_out) { l.get(); }
+
+        // The glyphs are placed in the atlas in a different order, so only the quads (and not the
+        // texture coordinates) can be compared
+        if (f_shared.glchars.size() != f_serial.glchars.size()) {
+            std::cout << "Fail: the shared face has " << f_shared.glchars.size() << " glyphs, not "
+                      << f_serial.glchars.size() << std::endl;
+            --rtn;
+        }
+        unsigned int n_differ = 0;
+        unsigned int n_outside = 0;
+        for (unsigned int i = 0; i < nt; ++i) {
+            if (t_par[i]->positions() != t_ser[i]->positions()) { ++n_differ; }
+            for (float uv : t_par[i]->texcoords()) { if (uv < 0.0f || uv > 1.0f) { ++n_outside; } }
+        }
+        if (n_differ > 0) { std::cout << "Fail: " << n_differ << " texts laid out on workers differ\n"; --rtn; }
+        if (n_outside > 0) { std::cout << "Fail: " << n_outside << " texture coordinates are outside the atlas\n"; --rtn; }
+
+        std::cout << nt << " texts laid out on " << text_pool.size() << " workers with one face of "
+                  << f_shared.glchars.size() << " glyphs\n";
+    }
+    FT_Done_FreeType (ft);
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
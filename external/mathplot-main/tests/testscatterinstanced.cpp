@@ -0,0 +1,185 @@
+/*
+ * Compare ScatterVisual's instanced markers with the original one-mesh-per-marker vertices.
+ *
+ * The vertices are computed CPU-side (no GL context or window is needed). For each marker
+ * style, the instanced markers are expanded with the same arithmetic as the 'instanced' branch
+ * of the default vertex shader and compared with the vertices of the original path. (Each rod
+ * of the original path is rotated randomly about its axis, so rod vertices are compared by
+ * their axial and radial distances from the marker's centre.) The vertex memory and the time
+ * taken to build each model are reported.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <array>
+
+#include <mplot/VisualMX.h>
+#include <mplot/ScatterVisual.h>
+#include <sm/vec>
+#include <sm/vvec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// Expose the vertex arrays of a ScatterVisual
+struct scatter_probe : public mplot::ScatterVisual<float>
+{
+    scatter_probe() : mplot::ScatterVisual<float> (sm::vec<float>{}) {}
+
+    std::size_t mesh_bytes() const
+    {
+        return (this->vertexPositions.size() + this->vertexNormals.size() + this->vertexColors.size()) * sizeof(float)
+        + this->indices.size() * sizeof(GLuint);
+    }
+
+    std::size_t instanced_bytes() const
+    {
+        std::size_t b = 0;
+        for (const auto& im : this->instmeshes) {
+            b += (im.vertexPositions.size() + im.vertexNormals.size()
+                  + im.instancePositions.size() + im.instanceColors.size()) * sizeof(float)
+            + im.indices.size() * sizeof(GLuint);
+        }
+        return b;
+    }
+
+    // Vertex v of marker i in the original path
+    sm::vec<float> mesh_vertex (std::size_t i, std::size_t v, std::size_t nv) const
+    {
+        const std::size_t j = 3u * (i * nv + v);
+        return { this->vertexPositions[j], this->vertexPositions[j + 1], this->vertexPositions[j + 2] };
+    }
+    sm::vec<float> mesh_colour (std::size_t i, std::size_t nv) const
+    {
+        const std::size_t j = 3u * i * nv;
+        return { this->vertexColors[j], this->vertexColors[j + 1], this->vertexColors[j + 2] };
+    }
+
+    // Vertex v of instance i, transformed as in the default vertex shader
+    sm::vec<float> instance_vertex (std::size_t i, std::size_t v) const
+    {
+        const auto& im = this->instmeshes[0];
+        sm::vec<float> p = { im.vertexPositions[3u * v], im.vertexPositions[3u * v + 1], im.vertexPositions[3u * v + 2] };
+        sm::vec<float> axial = im.axis * p.dot (im.axis);
+        return axial + (p - axial) * im.instancePositions[4u * i + 3] + this->instance_centre (i);
+    }
+    sm::vec<float> instance_centre (std::size_t i) const
+    {
+        const auto& im = this->instmeshes[0];
+        return { im.instancePositions[4u * i], im.instancePositions[4u * i + 1], im.instancePositions[4u * i + 2] };
+    }
+    sm::vec<float> instance_colour (std::size_t i) const
+    {
+        const auto& im = this->instmeshes[0];
+        return { im.instanceColors[3u * i], im.instanceColors[3u * i + 1], im.instanceColors[3u * i + 2] };
+    }
+
+    // What reinit_instances() does before it uploads the instance buffers
+    void update_instances()
+    {
+        this->instmeshes[0].clear_instances();
+        this->computeMarkers();
+    }
+
+    // The distances along and from the rod axis of a vertex at p on a rod centred at c
+    sm::vec<float, 2> rod_coords (const sm::vec<float>& p, const sm::vec<float>& c) const
+    {
+        sm::vec<float> axis = this->markerdirn;
+        axis.renormalize();
+        const float a = (p - c).dot (axis);
+        return { a, (p - c - axis * a).length() };
+    }
+
+    std::size_t mesh_vertices() const { return this->vertexPositions.size() / 3u; }
+    std::size_t unit_vertices() const { return this->instmeshes[0].vertexPositions.size() / 3u; }
+    std::size_t num_instances() const { return this->instmeshes[0].num_instances(); }
+};
+
+int main()
+{
+    int rtn = 0;
+
+    constexpr unsigned int n = 20000;
+    std::vector<sm::vec<float>> coords (n);
+    sm::vvec<float> data (n, 0.0f);
+    data.randomize();
+    sm::vvec<float> r (3u * n, 0.0f);
+    r.randomize();
+    for (unsigned int i = 0; i < n; ++i) { coords[i] = { r[3 * i], r[3 * i + 1], r[3 * i + 2] }; }
+
+    for (auto style : { mplot::markerstyle::sphere, mplot::markerstyle::rod }) {
+
+        scatter_probe sv_mesh;
+        sv_mesh.markers = style;
+        sv_mesh.markerdirn = { 0.0f, 0.02f, 0.01f };
+        sv_mesh.sizeFactor = 0.01f;
+        sv_mesh.setDataCoords (&coords);
+        sv_mesh.setScalarData (&data);
+
+        scatter_probe sv_inst;
+        sv_inst.markers = style;
+        sv_inst.markerdirn = sv_mesh.markerdirn;
+        sv_inst.sizeFactor = sv_mesh.sizeFactor;
+        sv_inst.instanced_markers = true;
+        sv_inst.setDataCoords (&coords);
+        sv_inst.setScalarData (&data);
+
+        sc::time_point t0 = sc::now();
+        sv_mesh.initializeVertices();
+        sc::duration t_mesh = sc::now() - t0;
+
+        t0 = sc::now();
+        sv_inst.initializeVertices();
+        sc::duration t_inst = sc::now() - t0;
+
+        const std::size_t inst_bytes = sv_inst.instanced_bytes();
+
+        t0 = sc::now();
+        sv_inst.update_instances();
+        sc::duration t_update = sc::now() - t0;
+
+        if (sv_inst.num_instances() != n) {
+            std::cout << "Fail: expected " << n << " instances, not " << sv_inst.num_instances() << std::endl;
+            --rtn;
+        }
+
+        const std::size_t nv = sv_inst.unit_vertices();
+        if (sv_mesh.mesh_vertices() != n * nv) {
+            std::cout << "Fail: the unit mesh does not have the same vertices as each marker\n";
+            --rtn;
+            continue;
+        }
+
+        float maxdiff = 0.0f;
+        float maxcoldiff = 0.0f;
+        for (std::size_t i = 0; i < n; i += 997) {
+            for (std::size_t v = 0; v < nv; ++v) {
+                sm::vec<float> pm = sv_mesh.mesh_vertex (i, v, nv);
+                sm::vec<float> pi = sv_inst.instance_vertex (i, v);
+                if (style == mplot::markerstyle::rod) {
+                    sm::vec<float> c = sv_inst.instance_centre (i);
+                    maxdiff = std::max (maxdiff, (sv_mesh.rod_coords (pm, c) - sv_inst.rod_coords (pi, c)).abs().max());
+                } else {
+                    maxdiff = std::max (maxdiff, (pm - pi).abs().max());
+                }
+            }
+            maxcoldiff = std::max (maxcoldiff, (sv_mesh.mesh_colour (i, nv) - sv_inst.instance_colour (i)).abs().max());
+        }
+        if (maxdiff > 1e-5f || maxcoldiff > 0.0f) {
+            std::cout << "Fail: instanced markers differ from the original markers by " << maxdiff
+                      << " (colour: " << maxcoldiff << ")\n";
+            --rtn;
+        }
+
+        std::cout << n << (style == mplot::markerstyle::rod ? " rods" : " spheres") << " (" << nv << " vertices each):\n"
+                  << "  one mesh per marker: " << sv_mesh.mesh_bytes() / 1024 << " KB, built in "
+                  << duration_cast<milliseconds>(t_mesh).count() << " ms\n"
+                  << "  instanced:           " << inst_bytes / 1024 << " KB, built in "
+                  << duration_cast<milliseconds>(t_inst).count() << " ms (updating the instances: "
+                  << duration_cast<milliseconds>(t_update).count() << " ms)\n";
+    }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
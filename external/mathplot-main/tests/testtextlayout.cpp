@@ -0,0 +1,184 @@
+/*
+ * Profile the CPU-side cost of text: setting up a font face, laying out 10000 labels and merging
+ * them into one batch mesh (as VisualModel does with batch_texts). Check that each label's quads
+ * and atlas texture coordinates survive the merge.
+ *
+ * The glyphs are rendered with FreeType, but no GL context or window is needed.
+ */
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory>
+
+#include <mplot/VisualMX.h>
+#include <mplot/VisualTextModelBase.h>
+#include <mplot/VisualFaceBase.h>
+#include <sm/mat44>
+#include <sm/vec>
+
+using namespace std::chrono;
+using sc = std::chrono::steady_clock;
+
+// A VisualFace without the GL texture
+struct face_probe : public mplot::visgl::VisualFaceBase
+{
+    face_probe (const mplot::VisualFont font, unsigned int fontpixels, FT_Library& ft, bool all_glyphs = false)
+    {
+        this->init_common (font, fontpixels, ft);
+        if (all_glyphs) {
+            // As VisualFace once did: load every glyph in the face
+            for (char32_t c = 0; c < 2097151; c++) {
+                if (FT_Get_Char_Index (this->face, c) != 0) { this->glyph (c); }
+            }
+        } else {
+            this->load_ascii();
+        }
+    }
+};
+
+// A VisualTextModel without the GL buffers
+struct text_probe : public mplot::VisualTextModelBase<>
+{
+    text_probe (const mplot::TextFeatures& tf) : mplot::VisualTextModelBase<> (tf) {}
+
+    void render() final {}
+    mplot::TextGeometry getTextGeometry (const std::string&) final { return {}; }
+    mplot::TextGeometry getTextGeometry() final { return {}; }
+
+    void setup (const std::string& s, const sm::vec<float>& offset, face_probe* f)
+    {
+        this->viewmatrix.translate (offset);
+        this->txt = mplot::unicode::fromUtf8 (s);
+        f->glyphs (this->txt);
+        this->layoutText (f);
+    }
+
+    void batch (const std::vector<const mplot::VisualTextModelBase<>*>& members, face_probe* f)
+    {
+        this->layoutBatch (members, f);
+    }
+
+    sm::vec<float> position (std::size_t v) const
+    {
+        return { this->vertexPositions[3 * v], this->vertexPositions[3 * v + 1], this->vertexPositions[3 * v + 2] };
+    }
+    sm::vec<float, 2> texcoord (std::size_t v) const { return { this->vertexTextures[3 * v], this->vertexTextures[3 * v + 1] }; }
+    sm::vec<float> colour (std::size_t v) const
+    {
+        return { this->vertexColors[3 * v], this->vertexColors[3 * v + 1], this->vertexColors[3 * v + 2] };
+    }
+    const sm::mat44<float>& view() const { return this->viewmatrix; }
+    std::size_t num_vertices() const { return this->vertexPositions.size() / 3; }
+    std::size_t num_indices() const { return this->indices.size(); }
+
+protected:
+    void postVertexInit() final {}
+    void setupVBO (GLuint&, std::vector<float>&, unsigned int) final {}
+};
+
+int main()
+{
+    int rtn = 0;
+
+    FT_Library ft;
+    if (FT_Init_FreeType (&ft)) { std::cout << "Could not init FreeType\nFAIL\n"; return -1; }
+
+    mplot::TextFeatures tf (0.05f, 48, false, mplot::colour::black, mplot::VisualFont::DVSans);
+
+    {
+        // Face set-up, loading every glyph vs. loading printable ASCII and adding others on demand
+        sc::time_point t0 = sc::now();
+        face_probe f_all (tf.font, tf.fontres, ft, true);
+        sc::duration t_all = sc::now() - t0;
+
+        t0 = sc::now();
+        face_probe f (tf.font, tf.fontres, ft);
+        sc::duration t_ascii = sc::now() - t0;
+
+        std::cout << "Face set-up at " << tf.fontres << " pixels:\n"
+                  << "  every glyph (" << f_all.glchars.size() << "): " << duration_cast<milliseconds>(t_all).count()
+                  << " ms, atlas " << f_all.atlas.width() << "x" << f_all.atlas.height() << "\n"
+                  << "  printable ASCII (" << f.glchars.size() << "): " << duration_cast<milliseconds>(t_ascii).count()
+                  << " ms, atlas " << f.atlas.width() << "x" << f.atlas.height() << "\n";
+
+        // A glyph outside ASCII is added on demand
+        const std::size_t nglyphs = f.glchars.size();
+        const mplot::visgl::CharInfo& alpha = f.glyph (U'α');
+        if (f.glchars.size() != nglyphs + 1 || alpha.atlas_rect[2] == 0 || alpha.advance == 0) {
+            std::cout << "Fail: Greek alpha was not loaded on demand\n";
+            --rtn;
+        }
+        // A character that is not in the face gets an empty glyph
+        if (f.glyph (U'\U0010fffd').advance != 0) { std::cout << "Fail: missing glyph\n"; --rtn; }
+
+        // 10000 labels, like the tick labels of a dashboard of graphs
+        constexpr unsigned int n = 10000;
+        std::vector<std::unique_ptr<text_probe>> labels;
+        labels.reserve (n);
+        std::size_t nquads = 0;
+        t0 = sc::now();
+        for (unsigned int i = 0; i < n; ++i) {
+            labels.push_back (std::make_unique<text_probe> (tf));
+            std::string s = std::to_string (static_cast<float>(i) * 0.125f - 300.0f);
+            if (i % 100 == 0) { s += " μm"; }
+            labels.back()->setup (s, { 0.01f * (i % 100), 0.02f * (i / 100), 0.0f }, &f);
+            labels.back()->clr_text = { (i % 3) / 2.0f, 0.0f, 0.5f };
+            nquads += labels.back()->numQuads();
+        }
+        sc::duration t_layout = sc::now() - t0;
+
+        std::vector<const mplot::VisualTextModelBase<>*> members;
+        for (auto& l : labels) { members.push_back (l.get()); }
+        text_probe batch (tf);
+        t0 = sc::now();
+        batch.batch (members, &f);
+        sc::duration t_batch = sc::now() - t0;
+
+        // Every label's quads must be in the batch, moved by the label's view matrix, with the
+        // same texture coordinates and coloured with the label's colour
+        if (batch.numQuads() != nquads || batch.num_vertices() != 4 * nquads || batch.num_indices() != 6 * nquads) {
+            std::cout << "Fail: the batch has " << batch.numQuads() << " quads, not " << nquads << std::endl;
+            --rtn;
+        }
+        std::size_t bv = 0;
+        float maxdiff = 0.0f;
+        float maxuvdiff = 0.0f;
+        float maxcoldiff = 0.0f;
+        for (auto& l : labels) {
+            for (std::size_t v = 0; v < l->num_vertices() && bv < batch.num_vertices(); ++v, ++bv) {
+                sm::vec<float, 4> p = l->view() * l->position (v);
+                maxdiff = std::max (maxdiff, (p.less_one_dim() - batch.position (bv)).abs().max());
+                maxuvdiff = std::max (maxuvdiff, (l->texcoord (v) - batch.texcoord (bv)).abs().max());
+                maxcoldiff = std::max (maxcoldiff, (sm::vec<float>{ l->clr_text[0], l->clr_text[1], l->clr_text[2] } - batch.colour (bv)).abs().max());
+            }
+        }
+        if (maxdiff > 1e-6f || maxuvdiff > 0.0f || maxcoldiff > 0.0f) {
+            std::cout << "Fail: the batch differs from the labels by " << maxdiff << " (texture coords: "
+                      << maxuvdiff << ", colours: " << maxcoldiff << ")\n";
+            --rtn;
+        }
+
+        // All texture coordinates lie within the atlas
+        for (std::size_t v = 0; v < batch.num_vertices(); ++v) {
+            sm::vec<float, 2> uv = batch.texcoord (v);
+            if (uv[0] < 0.0f || uv[0] > 1.0f || uv[1] < 0.0f || uv[1] > 1.0f) {
+                std::cout << "Fail: texture coordinate " << uv << " is outside the atlas\n";
+                --rtn;
+                break;
+            }
+        }
+
+        std::cout << n << " labels (" << nquads << " glyph quads):\n"
+                  << "  layout:        " << duration_cast<milliseconds>(t_layout).count() << " ms\n"
+                  << "  batch merge:   " << duration_cast<milliseconds>(t_batch).count() << " ms\n"
+                  << "  draw calls: " << nquads << " with one texture per glyph, "
+                  << n << " with one atlas per face, 1 batched\n";
+    }
+
+    FT_Done_FreeType (ft);
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}